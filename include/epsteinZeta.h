@@ -46,6 +46,512 @@ double complex epsteinZeta(double nu, unsigned int dim, const double *a,
 double complex epsteinZetaReg(double nu, unsigned int dim, const double *a,
                               const double *x, const double *y);
 
+/**
+ * @brief calculates the Epstein zeta function up to a tolerance. The cutoffs of
+ * the lattice sums in Crandall's formula are derived from a bound on the
+ * neglected summands, such that lower accuracy needs fewer summands.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums,
+ * relative to the leading summands. It approximates the relative error of the
+ * result, unless the sums cancel. 0 for full double precision as in
+ * epsteinZeta.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaTol(double nu, unsigned int dim, const double *a,
+                              const double *x, const double *y, double tol);
+
+/**
+ * @brief calculates the regularized Epstein zeta function up to a tolerance, see
+ * epsteinZetaTol.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums, 0
+ * for full double precision as in epsteinZetaReg.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaRegTol(double nu, unsigned int dim, const double *a,
+                                 const double *x, const double *y, double tol);
+
+/**
+ * @brief calculates the Epstein zeta function with the lattice sums in single
+ * precision, for a relative accuracy of about 1e-6. The summands, phases and
+ * values of G are computed in float with twice the SIMD width of epsteinZeta,
+ * the cutoffs follow from a tolerance of 1e-6.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta.
+ */
+float complex epsteinZetaf(float nu, unsigned int dim, const float *a,
+                           const float *x, const float *y);
+
+/**
+ * @brief calculates the regularized Epstein zeta function with the lattice sums
+ * in single precision, see epsteinZetaf.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta.
+ */
+float complex epsteinZetaRegf(float nu, unsigned int dim, const float *a,
+                              const float *x, const float *y);
+
+/**
+ * @brief calculates the Epstein zeta function in quadruple precision. The lattice
+ * sums, the incomplete gamma functions and the assembly of Crandall's formula
+ * are computed with __float128, such that the result is accurate to double
+ * precision, also where epsteinZeta loses digits to cancellation or to the
+ * asymptotic expansion of G. Several hundred times slower than epsteinZeta,
+ * only available if the library is built with __float128 support.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta, NAN if the library is built
+ * without quadruple precision.
+ */
+double complex epsteinZetaQuad(double nu, unsigned int dim, const double *a,
+                               const double *x, const double *y);
+
+/**
+ * @brief calculates the regularized Epstein zeta function in quadruple
+ * precision, see epsteinZetaQuad. The cancellation between the sums and the
+ * regularization for small y does not cost digits.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta, NAN if the library is
+ * built without quadruple precision.
+ */
+double complex epsteinZetaRegQuad(double nu, unsigned int dim, const double *a,
+                                  const double *x, const double *y);
+
+/**
+ * @brief calculates the Epstein zeta function with a given weight of the sums
+ * in Crandall's formula. epsteinZeta chooses the weight from the lattice, such
+ * that the number of summands is minimal, this function is meant for tuning
+ * studies.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula for the
+ * lattice scaled to unit volume. The cutoffs of the sums scale with lambda and
+ * 1 / lambda, values far from 1 lose accuracy. 0 chooses it from the lattice.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaLambda(double nu, unsigned int dim, const double *a,
+                                 const double *x, const double *y, double lambda);
+
+/**
+ * @brief calculates the regularized Epstein zeta function with a given weight of
+ * the sums in Crandall's formula, see epsteinZetaLambda.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula for the
+ * lattice scaled to unit volume, 0 chooses it from the lattice.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaRegLambda(double nu, unsigned int dim, const double *a,
+                                    const double *x, const double *y,
+                                    double lambda);
+
+/**
+ * @brief calculates the Epstein zeta function and its gradients with respect to
+ * x and y. The derivatives of the summands in Crandall's formula are summed in
+ * the same traversal of both lattices as the function value.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[out] gradX: dim derivatives with respect to the entries of x.
+ * @param[out] gradY: dim derivatives with respect to the entries of y.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaGrad(double nu, unsigned int dim, const double *a,
+                               const double *x, const double *y,
+                               double complex *gradX, double complex *gradY);
+
+/**
+ * @brief calculates the regularized Epstein zeta function and its gradients with
+ * respect to x and y, see epsteinZetaGrad.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[out] gradX: dim derivatives with respect to the entries of x.
+ * @param[out] gradY: dim derivatives with respect to the entries of y.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaRegGrad(double nu, unsigned int dim, const double *a,
+                                  const double *x, const double *y,
+                                  double complex *gradX, double complex *gradY);
+
+/**
+ * @brief calculates the Epstein zeta function, its gradient and its Hessian with
+ * respect to x, such as for the dynamical matrices of lattice dynamics. The
+ * second derivatives of the summands in Crandall's formula are summed in the
+ * same traversal of both lattices as the function value.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[out] gradX: dim derivatives with respect to the entries of x.
+ * @param[out] hessX: dim x dim second derivatives with respect to the entries
+ * of x, in row-major order.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaHessian(double nu, unsigned int dim, const double *a,
+                                  const double *x, const double *y,
+                                  double complex *gradX, double complex *hessX);
+
+/**
+ * @brief calculates the regularized Epstein zeta function, its gradient and its
+ * Hessian with respect to x, see epsteinZetaHessian.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[out] gradX: dim derivatives with respect to the entries of x.
+ * @param[out] hessX: dim x dim second derivatives with respect to the entries
+ * of x, in row-major order.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaRegHessian(double nu, unsigned int dim,
+                                     const double *a, const double *x,
+                                     const double *y, double complex *gradX,
+                                     double complex *hessX);
+
+/**
+ * @brief calculates the first n Taylor coefficients of the Epstein zeta function
+ * in the exponent nu, such as for fits of effective exponents. The prefactor
+ * and the summands of Crandall's formula are expanded analytically in nu and
+ * summed in one traversal of both lattices, which stays accurate near
+ * nu = dim, where finite differences in nu are unstable.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of coefficients.
+ * @param[out] out: n coefficients (d / d nu)^k Z(nu) / k! for k = 0, ..., n - 1,
+ * NAN at the pole nu = dim for y on the reciprocal lattice.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaTaylorNu(double nu, unsigned int dim, const double *a,
+                        const double *x, const double *y, unsigned int n,
+                        double complex *out);
+
+/**
+ * @brief calculates the first n Taylor coefficients of the regularized Epstein
+ * zeta function in the exponent nu, see epsteinZetaTaylorNu.
+ * @param[in] nu: exponent for the regularized Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of coefficients.
+ * @param[out] out: n coefficients (d / d nu)^k Z_reg(nu) / k! for
+ * k = 0, ..., n - 1, NAN at the poles nu = dim + 2 k for y off the origin and
+ * at nu = dim.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaRegTaylorNu(double nu, unsigned int dim, const double *a,
+                           const double *x, const double *y, unsigned int n,
+                           double complex *out);
+
+/**
+ * @brief opaque plan for repeated evaluations of the (regularized) Epstein zeta
+ * function with a fixed exponent and lattice.
+ */
+typedef struct epsteinZetaPlan epsteinZetaPlan;
+
+/**
+ * @brief precomputes everything that only depends on the exponent and the
+ * lattice, that is the inverse and scaling of the lattice matrix and the cutoffs
+ * of Crandall's formula.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @return plan for epsteinZetaPlanExecute and epsteinZetaPlanExecuteReg, NULL if
+ * memory allocation fails. Has to be freed with epsteinZetaPlanDestroy.
+ */
+epsteinZetaPlan *epsteinZetaPlanCreate(double nu, unsigned int dim, const double *a);
+
+/**
+ * @brief precomputes everything that only depends on the exponent, the lattice
+ * and the tolerance, see epsteinZetaTol.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums, 0
+ * for full double precision as in epsteinZetaPlanCreate.
+ * @return plan for epsteinZetaPlanExecute and epsteinZetaPlanExecuteReg, NULL if
+ * memory allocation fails. Has to be freed with epsteinZetaPlanDestroy.
+ */
+epsteinZetaPlan *epsteinZetaPlanCreateTol(double nu, unsigned int dim,
+                                          const double *a, double tol);
+
+/**
+ * @brief precomputes everything that only depends on the exponent, the lattice
+ * and the tolerance, see epsteinZetaPlanCreateTol, and additionally tabulates
+ * the summand function G of both lattice sums with piecewise Chebyshev
+ * polynomials. The tables take a few milliseconds to create and make every
+ * execution of the plan faster, so they pay off for many evaluations. If the
+ * tables would not reach full double precision for an exponent, that sum
+ * evaluates G directly.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums, 0
+ * for full double precision.
+ * @return plan for epsteinZetaPlanExecute and epsteinZetaPlanExecuteReg, NULL if
+ * memory allocation fails. Has to be freed with epsteinZetaPlanDestroy.
+ */
+epsteinZetaPlan *epsteinZetaPlanCreateTabulated(double nu, unsigned int dim,
+                                                const double *a, double tol);
+
+/**
+ * @brief calculates the Epstein zeta function for a precomputed plan.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaPlanExecute(const epsteinZetaPlan *plan, const double *x,
+                                      const double *y);
+
+/**
+ * @brief calculates the regularized Epstein zeta function for a precomputed plan.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaPlanExecuteReg(const epsteinZetaPlan *plan,
+                                         const double *x, const double *y);
+
+/**
+ * @brief calculates the Epstein zeta function for a precomputed plan with the
+ * lattice sums in single precision, see epsteinZetaf. Plans created by
+ * epsteinZetaPlanCreateTol with a tolerance of 1e-6 match its accuracy.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta.
+ */
+float complex epsteinZetaPlanExecutef(const epsteinZetaPlan *plan, const float *x,
+                                      const float *y);
+
+/**
+ * @brief calculates the regularized Epstein zeta function for a precomputed plan
+ * with the lattice sums in single precision, see epsteinZetaPlanExecutef.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta.
+ */
+float complex epsteinZetaPlanExecuteRegf(const epsteinZetaPlan *plan,
+                                         const float *x, const float *y);
+
+/**
+ * @brief calculates the Epstein zeta function for a precomputed plan in
+ * quadruple precision, see epsteinZetaQuad. The cutoffs of the plan are
+ * replaced by cutoffs for quadruple precision.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta, NAN if the library is built
+ * without quadruple precision.
+ */
+double complex epsteinZetaPlanExecuteQuad(const epsteinZetaPlan *plan,
+                                          const double *x, const double *y);
+
+/**
+ * @brief calculates the regularized Epstein zeta function for a precomputed plan
+ * in quadruple precision, see epsteinZetaPlanExecuteQuad.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta, NAN if the library is
+ * built without quadruple precision.
+ */
+double complex epsteinZetaPlanExecuteRegQuad(const epsteinZetaPlan *plan,
+                                             const double *x, const double *y);
+
+/**
+ * @brief frees a plan created by epsteinZetaPlanCreate.
+ * @param[in, out] plan: plan to free, may be NULL.
+ */
+void epsteinZetaPlanDestroy(epsteinZetaPlan *plan);
+
+/**
+ * @brief calculates the Epstein zeta function for many y vectors and one x
+ * vector. The summands of the first sum in Crandall's formula, that do not
+ * depend on y, are only computed once.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] ys: n y vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] n: number of y vectors.
+ * @param[out] out: n function values of the Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchY(double nu, unsigned int dim, const double *a, const double *x,
+                      const double *ys, unsigned int n, double complex *out);
+
+/**
+ * @brief calculates the regularized Epstein zeta function for many y vectors and
+ * one x vector. The summands of the first sum in Crandall's formula, that do not
+ * depend on y, are only computed once.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] ys: n y vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] n: number of y vectors.
+ * @param[out] out: n function values of the regularized Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaRegBatchY(double nu, unsigned int dim, const double *a,
+                         const double *x, const double *ys, unsigned int n,
+                         double complex *out);
+
+/**
+ * @brief calculates the Epstein zeta function for many x vectors and one y
+ * vector. The summands of the second sum in Crandall's formula, that do not
+ * depend on x, are only computed once.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] xs: n x vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of x vectors.
+ * @param[out] out: n function values of the Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchX(double nu, unsigned int dim, const double *a, const double *xs,
+                      const double *y, unsigned int n, double complex *out);
+
+/**
+ * @brief calculates the regularized Epstein zeta function for many x vectors and
+ * one y vector. The summands of the second sum in Crandall's formula, that do not
+ * depend on x, are only computed once.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] xs: n x vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of x vectors.
+ * @param[out] out: n function values of the regularized Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaRegBatchX(double nu, unsigned int dim, const double *a,
+                         const double *xs, const double *y, unsigned int n,
+                         double complex *out);
+
+/**
+ * @brief calculates the Epstein zeta function for many exponents nu and one
+ * lattice, x and y. Both lattice sums are traversed only once for all exponents.
+ * @param[in] nus: n exponents for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of exponents.
+ * @param[out] out: n function values of the Epstein zeta, NAN if memory
+ * allocation fails.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchNu(const double *nus, unsigned int dim, const double *a,
+                       const double *x, const double *y, unsigned int n,
+                       double complex *out);
+
+/**
+ * @brief calculates the regularized Epstein zeta function for many exponents nu
+ * and one lattice, x and y. Both lattice sums are traversed only once for all
+ * exponents.
+ * @param[in] nus: n exponents for the regularized Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of exponents.
+ * @param[out] out: n function values of the regularized Epstein zeta, NAN if
+ * memory allocation fails.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaRegBatchNu(const double *nus, unsigned int dim, const double *a,
+                          const double *x, const double *y, unsigned int n,
+                          double complex *out);
+
+/**
+ * @brief one independent evaluation of the (regularized) Epstein zeta function
+ * in a call to epsteinZetaBatchTasks.
+ */
+typedef struct epsteinZetaTask {
+    double nu;             //!< exponent for the Epstein zeta function.
+    unsigned int dim;      //!< dimension of the input vectors.
+    const double *a;       //!< matrix that transforms the lattice.
+    const double *x;       //!< x vector of the Epstein Zeta function.
+    const double *y;       //!< y vector of the Epstein Zeta function.
+    int reg;               //!< 0 for no regularization, > 0 for the regularization.
+    double complex result; //!< function value, set by epsteinZetaBatchTasks.
+} epsteinZetaTask;
+
+/**
+ * @brief evaluates many independent (regularized) Epstein zeta functions with
+ * possibly different exponents, dimensions and lattices. The evaluations are
+ * distributed to a work-stealing pool of epsteinZetaGetNumThreads() threads and
+ * the evaluations with the most summands are started first.
+ * @param[in, out] tasks: n evaluations, their result is set on return.
+ * @param[in] n: number of evaluations.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchTasks(epsteinZetaTask *tasks, unsigned int n);
+
+/**
+ * @brief sets the number of threads used within a single evaluation of the
+ * Epstein zeta function. Threading is off by default. The setting applies to
+ * the whole process and should not be changed while evaluations are running.
+ * @param[in] n: number of threads, 0 and 1 both disable threading.
+ */
+void epsteinZetaSetNumThreads(unsigned int n);
+
+/**
+ * @brief gets the number of threads used within a single evaluation of the
+ * Epstein zeta function.
+ * @return number of threads, at least 1.
+ */
+unsigned int epsteinZetaGetNumThreads(void);
+
 #ifndef EPSTEIN_CRANDALL
 
 /**
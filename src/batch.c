@@ -0,0 +1,370 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file batch.c
+ * @brief Evaluates the (regularized) Epstein zeta function for many arguments
+ * at once.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "crandall.h"
+#include "lattice.h"
+#include "threads.h"
+#include "tools.h"
+#include "zeta.h"
+
+#include "batch.h"
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function for many y vectors
+ * and one x vector, computing the values of G in the first sum only once.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] ys: n y vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] n: number of y vectors.
+ * @param[out] out: n function values of the (regularized) Epstein zeta.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchYInternal(double nu, unsigned int dim, const double *m,
+                              const double *x, const double *ys, unsigned int n,
+                              double complex *out, double lambda, int reg) {
+    struct epsteinZetaPlan *plan = epsteinZetaPlanInternal(nu, dim, m, lambda, 0);
+    if (plan == NULL) {
+        return 1;
+    }
+    // the first sum only depends on y through the phases
+    struct epsteinZetaSumTable *realTable = epsteinZetaRealTable(plan, x);
+    if (realTable == NULL) {
+        epsteinZetaPlanFree(plan);
+        return 1;
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        out[i] = epsteinZetaPlanExecuteTables(plan, x, ys + (long)i * dim, reg,
+                                              realTable, NULL);
+    }
+    epsteinZetaSumTableFree(realTable);
+    epsteinZetaPlanFree(plan);
+    return 0;
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function for many x vectors
+ * and one y vector, computing the values of G in the second sum only once.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] xs: n x vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of x vectors.
+ * @param[out] out: n function values of the (regularized) Epstein zeta.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchXInternal(double nu, unsigned int dim, const double *m,
+                              const double *xs, const double *y, unsigned int n,
+                              double complex *out, double lambda, int reg) {
+    struct epsteinZetaPlan *plan = epsteinZetaPlanInternal(nu, dim, m, lambda, 0);
+    if (plan == NULL) {
+        return 1;
+    }
+    // the second sum only depends on x through the phases
+    struct epsteinZetaSumTable *fourierTable = epsteinZetaFourierTable(plan, y);
+    if (fourierTable == NULL) {
+        epsteinZetaPlanFree(plan);
+        return 1;
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        out[i] = epsteinZetaPlanExecuteTables(plan, xs + (long)i * dim, y, reg,
+                                              NULL, fourierTable);
+    }
+    epsteinZetaSumTableFree(fourierTable);
+    epsteinZetaPlanFree(plan);
+    return 0;
+}
+
+/**
+ * @brief adds a summand to a sum using Kahan's method.
+ * @param[in, out] sum: running sum.
+ * @param[in, out] epsilon: running compensation.
+ * @param[in] summand: summand to add.
+ */
+void kahanAdd(double complex *sum, double complex *epsilon,
+              double complex summand) {
+    double complex auxy = summand - *epsilon;
+    double complex auxt = *sum + auxy;
+    *epsilon = (auxt - *sum) - auxy;
+    *sum = auxt;
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function for many exponents
+ * nu and fixed lattice, x and y in one traversal of both lattices. The lattice
+ * points and phases are computed once for all exponents, and G is evaluated
+ * with the upward recurrence for exponents that differ by even integers.
+ * @param[in] nus: n exponents for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of exponents.
+ * @param[out] out: n function values of the (regularized) Epstein zeta, NAN if
+ * memory allocation fails.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchNuInternal(const double *nus, unsigned int dim,
+                               const double *m, const double *x, const double *y,
+                               unsigned int n, double complex *out, double lambda,
+                               int reg) {
+    if (n == 0) {
+        return 0;
+    }
+    // the lattice data does not depend on nu
+    struct epsteinZetaPlan *plan =
+        epsteinZetaPlanInternal(nus[0], dim, m, lambda, 0);
+    int *chains = malloc(6 * n * sizeof(int));
+    double *buf = malloc(4 * n * sizeof(double));
+    double complex *sums = malloc(4 * n * sizeof(double complex));
+    if (plan == NULL || chains == NULL || buf == NULL || sums == NULL) {
+        for (int i = 0; i < n; i++) {
+            out[i] = NAN;
+        }
+        epsteinZetaPlanFree(plan);
+        free(chains);
+        free(buf);
+        free(sums);
+        return 1;
+    }
+    double *nusFourier = buf;
+    double *zArgBounds = buf + n;
+    double *gReal = buf + 2 * n;
+    double *gFourier = buf + 3 * n;
+    double complex *s1 = sums;
+    double complex *e1 = sums + n;
+    double complex *s2 = sums + 2 * n;
+    double complex *e2 = sums + 3 * n;
+    for (int i = 0; i < n; i++) {
+        nusFourier[i] = dim - nus[i];
+        zArgBounds[i] = assignzArgBound(nus[i]);
+        s1[i] = e1[i] = s2[i] = e2[i] = 0;
+    }
+    crandall_gChainInit(n, nus, chains, chains + n, chains + 2 * n);
+    crandall_gChainInit(n, nusFourier, chains + 3 * n, chains + 4 * n,
+                        chains + 5 * n);
+
+    double x_t1[dim];
+    double y_t1[dim];
+    for (int i = 0; i < dim; i++) {
+        x_t1[i] = x[i] * plan->ms;
+        y_t1[i] = y[i] / plan->ms;
+    }
+    double *x_t2 = vectorProj(dim, plan->m_real, plan->m_realInvt, x_t1);
+    double *y_t2 = vectorProj(dim, plan->m_realInvt, plan->m_real, y_t1);
+    const double *xf = reg ? x_t1 : x_t2;
+
+    // First Sum (in real space)
+    double shift[dim];
+    for (int i = 0; i < dim; i++) {
+        shift[i] = -x_t2[i];
+    }
+    struct latticeRows *rowsReal =
+        latticeRowsCreate(dim, plan->m_real, shift, plan->radiusReal);
+    struct latticeRows *rowsFourier =
+        latticeRowsCreate(dim, plan->m_fourier, y_t2, plan->radiusFourier);
+    int status = rowsReal == NULL || rowsFourier == NULL;
+    if (status) {
+        for (int i = 0; i < n; i++) {
+            out[i] = NAN;
+        }
+        latticeRowsFree(rowsReal);
+        latticeRowsFree(rowsFourier);
+        free(x_t2);
+        free(y_t2);
+        free(chains);
+        free(buf);
+        free(sums);
+        epsteinZetaPlanFree(plan);
+        return status;
+    }
+    const struct latticeRows *rows = rowsReal;
+    double complex phasesReal[phaseTableSize(rows)];
+    long offsets[dim];
+    phaseTable(dim, plan->m_real, y_t2, rows, phasesReal, offsets);
+    double argScale = M_PI / (plan->lambda * plan->lambda);
+    struct latticeWalker *walker = latticeWalkerCreate(
+        dim, plan->m_real, shift, rows, LATTICE_EXACT_ARG / argScale, 0);
+    status = status || walker == NULL;
+    for (long l = 0; walker != NULL && l < rows->nPoints; l++) {
+        double complex rot = 1;
+        for (int k = 0; k < dim; k++) {
+            rot *= phasesReal[offsets[k] + walker->zv[k] - rows->lower[k]];
+        }
+        double zArgument = walker->r2 * argScale;
+        crandall_gChain(n, nus, chains, chains + n, chains + 2 * n, zArgument,
+                        zArgBounds, gReal);
+        for (int i = 0; i < n; i++) {
+            kahanAdd(s1 + i, e1 + i, rot * gReal[i]);
+        }
+        latticeWalkerNext(walker);
+    }
+    latticeWalkerFree(walker);
+    // second sum (in fourier space), skips zero
+    rows = rowsFourier;
+    double complex phasesFourier[phaseTableSize(rows)];
+    phaseTable(dim, plan->m_fourier, xf, rows, phasesFourier, offsets);
+    double complex rotY = cexp(-2 * M_PI * I * dot(dim, y_t2, xf));
+    argScale = M_PI * plan->lambda * plan->lambda;
+    walker = latticeWalkerCreate(dim, plan->m_fourier, y_t2, rows,
+                                 LATTICE_EXACT_ARG / argScale, 0);
+    status = status || walker == NULL;
+    for (long l = 0; walker != NULL && l < rows->nPoints;
+         l++, latticeWalkerNext(walker)) {
+        if (l == rows->zeroIndex) {
+            continue;
+        }
+        double complex rot = rotY;
+        for (int k = 0; k < dim; k++) {
+            rot *= phasesFourier[offsets[k] + walker->zv[k] - rows->lower[k]];
+        }
+        double zArgument = walker->r2 * argScale;
+        crandall_gChain(n, nusFourier, chains + 3 * n, chains + 4 * n,
+                        chains + 5 * n, zArgument, zArgBounds, gFourier);
+        for (int i = 0; i < n; i++) {
+            kahanAdd(s2 + i, e2 + i, rot * gFourier[i]);
+        }
+    }
+    latticeWalkerFree(walker);
+    latticeRowsFree(rowsReal);
+    latticeRowsFree(rowsFourier);
+
+    for (int i = 0; i < n; i++) {
+        if (status) {
+            // the sums are incomplete if a walker could not be allocated
+            out[i] = NAN;
+            continue;
+        }
+        double complex res;
+        if (!specialCase(nus[i], dim, x_t1, x_t2, y_t2, reg, &res)) {
+            res = assembleCrandall(plan, nus[i], zArgBounds[i], x_t1, x_t2, y_t1,
+                                   y_t2, reg, s1[i], s2[i]);
+        }
+        out[i] = pow(plan->ms, nus[i]) * res;
+    }
+    free(x_t2);
+    free(y_t2);
+    free(chains);
+    free(buf);
+    free(sums);
+    epsteinZetaPlanFree(plan);
+    return status;
+}
+
+/**
+ * @brief predicted cost of a task for ordering the tasks of a batch.
+ */
+struct taskCost {
+    long cost;  //!< estimated number of summands in both sums.
+    long index; //!< index of the task.
+};
+
+/**
+ * @brief orders tasks by decreasing cost and increasing index.
+ * @param[in] a: pointer to a struct taskCost.
+ * @param[in] b: pointer to a struct taskCost.
+ * @return negative if a comes first, positive if b comes first.
+ */
+int taskCostCompare(const void *a, const void *b) {
+    const struct taskCost *ta = a;
+    const struct taskCost *tb = b;
+    if (ta->cost != tb->cost) {
+        return (ta->cost < tb->cost) ? 1 : -1;
+    }
+    return (ta->index > tb->index) - (ta->index < tb->index);
+}
+
+/**
+ * @brief data shared by the tasks of a batch.
+ */
+struct taskBatch {
+    epsteinZetaTask *tasks;         //!< evaluations of the batch.
+    struct epsteinZetaPlan **plans; //!< plans of the evaluations.
+};
+
+/**
+ * @brief runs one evaluation of a batch.
+ * @param[in, out] ctx: pointer to a struct taskBatch.
+ * @param[in] i: index of the evaluation.
+ */
+void taskBatchRun(void *ctx, long i) {
+    struct taskBatch *batch = ctx;
+    epsteinZetaTask *task = batch->tasks + i;
+    task->result = epsteinZetaPlanExecuteInternal(batch->plans[i], task->x,
+                                                  task->y, task->reg);
+}
+
+/**
+ * @brief evaluates many independent (regularized) Epstein zeta functions on a
+ * work-stealing pool, starting with the evaluations with the most summands.
+ * The plans are created up front, their cutoff radii give an estimate of the
+ * number of summands of each evaluation.
+ * @param[in, out] tasks: n evaluations, their result is set on return.
+ * @param[in] n: number of evaluations.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchTasksInternal(epsteinZetaTask *tasks, unsigned int n,
+                                  double lambda) {
+    struct epsteinZetaPlan **plans = calloc(n, sizeof(struct epsteinZetaPlan *));
+    struct taskCost *costs = malloc(n * sizeof(struct taskCost));
+    long *order = malloc(n * sizeof(long));
+    int status = (plans == NULL || costs == NULL || order == NULL);
+    for (long i = 0; i < n && !status; i++) {
+        plans[i] = epsteinZetaPlanInternal(tasks[i].nu, tasks[i].dim, tasks[i].a,
+                                           lambda, 0);
+        if (plans[i] == NULL) {
+            status = 1;
+            break;
+        }
+        costs[i].cost = ballVolume(tasks[i].dim, plans[i]->radiusReal) +
+                        ballVolume(tasks[i].dim, plans[i]->radiusFourier);
+        costs[i].index = i;
+    }
+    if (status == 0) {
+        qsort(costs, n, sizeof(struct taskCost), taskCostCompare);
+        for (long i = 0; i < n; i++) {
+            order[i] = costs[i].index;
+        }
+        struct taskBatch batch = {tasks, plans};
+        threadsRunPool(n, order, taskBatchRun, &batch);
+    }
+    for (long i = 0; plans != NULL && i < n; i++) {
+        epsteinZetaPlanFree(plans[i]);
+    }
+    free(plans);
+    free(costs);
+    free(order);
+    return status;
+}
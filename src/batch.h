@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file batch.h
+ * @brief Evaluates the (regularized) Epstein zeta function for many arguments
+ * at once.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+#include <complex.h>
+
+#include "epsteinZeta.h"
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function for many y vectors
+ * and one x vector, computing the values of G in the first sum only once.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] ys: n y vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] n: number of y vectors.
+ * @param[out] out: n function values of the (regularized) Epstein zeta.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchYInternal(double nu, unsigned int dim, const double *m,
+                              const double *x, const double *ys, unsigned int n,
+                              double complex *out, double lambda, int reg);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function for many x vectors
+ * and one y vector, computing the values of G in the second sum only once.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] xs: n x vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of x vectors.
+ * @param[out] out: n function values of the (regularized) Epstein zeta.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchXInternal(double nu, unsigned int dim, const double *m,
+                              const double *xs, const double *y, unsigned int n,
+                              double complex *out, double lambda, int reg);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function for many exponents
+ * nu and fixed lattice, x and y in one traversal of both lattices.
+ * @param[in] nus: n exponents for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of exponents.
+ * @param[out] out: n function values of the (regularized) Epstein zeta.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchNuInternal(const double *nus, unsigned int dim,
+                               const double *m, const double *x, const double *y,
+                               unsigned int n, double complex *out, double lambda,
+                               int reg);
+
+/**
+ * @brief evaluates many independent (regularized) Epstein zeta functions on a
+ * work-stealing pool, starting with the evaluations with the most summands.
+ * @param[in, out] tasks: n evaluations, their result is set on return.
+ * @param[in] n: number of evaluations.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchTasksInternal(epsteinZetaTask *tasks, unsigned int n,
+                                  double lambda);
+#endif
@@ -12,9 +12,24 @@
  */
 
 #include <complex.h>
+#include <stdbool.h>
+
+#include "gamma.h"
 
 #ifndef EPSTEIN_CRANDALL
 #define EPSTEIN_CRANDALL
+
+/**
+ * @brief piecewise Chebyshev interpolation of exp(t) G(t) for a fixed exponent,
+ * on pieces of equal length within each octave of the arguments t.
+ */
+struct crandallGTable {
+    double nu;      //!< exponent of G.
+    double tMin;    //!< smallest tabulated argument, a power of two.
+    double tMax;    //!< largest tabulated argument.
+    double *coeffs; //!< Chebyshev coefficients of all pieces.
+};
+
 /**
  * @brief Calculates the regularization of the zero summand in the second
  * sum in Crandall's formula in the special case of
@@ -55,6 +70,38 @@ double complex crandall_gReg(unsigned int dim, double nu, const double *z,
  */
 double assignzArgBound(double nu);
 
+/**
+ * @brief bounds the sum of G over the points of a lattice of unit volume outside
+ * of a ball by the integral of a bound on G over the exterior of the ball.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] nu: exponent of G.
+ * @param[in] radius: radius of the ball.
+ * @return bound on the sum, infinity if the bound on G does not hold.
+ */
+double crandall_gTail(unsigned int dim, double nu, double radius);
+
+/**
+ * @brief calculates the radius beyond which the summands G of a lattice of unit
+ * volume can be neglected for a given tolerance.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] nu: exponent of G.
+ * @param[in] tol: bound for the sum of the neglected summands.
+ * @return cutoff radius, at least 1.
+ */
+double crandall_gCutoff(unsigned int dim, double nu, double tol);
+
+/**
+ * @brief calculates a bound on when to use the asymptotic expansion of the upper
+ * incomplete gamma function in G for a given tolerance.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] nu: exponent of G.
+ * @param[in] tol: bound for the error of all summands in the asymptotic
+ * expansion.
+ * @return minimum value of z, when to use the asymptotic expansion, at most
+ * assignzArgBound(nu).
+ */
+double crandall_zArgBoundTol(unsigned int dim, double nu, double tol);
+
 /**
  * @brief Assumes x and y to be in the respective elementary lattice cell.
  * Multiply with exp(2 * PI * i * x * y) to get the second sum in Crandall's
@@ -68,4 +115,113 @@ double assignzArgBound(double nu);
  */
 double complex crandall_g(unsigned int dim, double nu, const double *z,
                           double prefactor, double zArgBound);
+
+/**
+ * @brief calculates G from the already scaled squared norm of its argument.
+ * @param[in] nu: exponent of the regularized Epstein zeta function.
+ * @param[in] zArgument: pi * prefactor ** 2 * z ** 2
+ * @param[in] zArgBound: bound on when to use the asymptotic expansion.
+ * @return upperGamma(nu/2, zArgument) / zArgument^(nu / 2)
+ */
+double crandall_gArg(double nu, double zArgument, double zArgBound);
+
+/**
+ * @brief checks whether G has a closed form for an exponent, that is, whether
+ * nu / 2 is a positive integer or half-integer of at most 16.
+ * @param[in] nu: exponent of G.
+ * @return true if crandall_gClosedBlock can evaluate G for nu.
+ */
+bool crandall_gHasClosedForm(double nu);
+
+/**
+ * @brief calculates G for a block of arguments and an exponent with a closed
+ * form, see crandall_gHasClosedForm.
+ * @param[in] nu: exponent of G.
+ * @param[in] n: number of arguments.
+ * @param[in] zArguments: n positive values of pi * prefactor ** 2 * z ** 2.
+ * @param[in] es: n values of exp(-zArguments).
+ * @param[out] g: n values of G.
+ */
+void crandall_gClosedBlock(double nu, unsigned int n, const double *zArguments,
+                           const double *es, double *g);
+
+/**
+ * @brief sorts several exponents of G into chains of exponents, that differ by
+ * even integers, such that G can be evaluated with the upward recurrence
+ * G_{nu + 2}(t) = (nu / 2 * G_nu(t) + exp(-t)) / t.
+ * @param[in] n: number of exponents.
+ * @param[in] nus: exponents of G.
+ * @param[out] order: indices of the exponents in the order of evaluation.
+ * @param[out] prev: for each index, the index of the exponent to start the
+ * recurrence from, or -1 if G has to be evaluated directly.
+ * @param[out] steps: for each index, the number of recurrence steps.
+ */
+void crandall_gChainInit(unsigned int n, const double *nus, int *order, int *prev,
+                         int *steps);
+
+/**
+ * @brief calculates G for several exponents at the same argument, using the
+ * upward recurrence between exponents in the same chain.
+ * @param[in] n: number of exponents.
+ * @param[in] nus: exponents of G.
+ * @param[in] order: order of evaluation from crandall_gChainInit.
+ * @param[in] prev: start of the recurrence from crandall_gChainInit.
+ * @param[in] steps: number of recurrence steps from crandall_gChainInit.
+ * @param[in] zArgument: pi * prefactor ** 2 * z ** 2
+ * @param[in] zArgBounds: bounds on when to use the asymptotic expansion for each
+ * exponent.
+ * @param[out] g: values of G for each exponent.
+ */
+void crandall_gChain(unsigned int n, const double *nus, const int *order,
+                     const int *prev, const int *steps, double zArgument,
+                     const double *zArgBounds, double *g);
+
+/**
+ * @brief tabulates G for a fixed exponent, such that crandall_gBlock evaluates
+ * the arguments below the asymptotic expansion by a short polynomial instead of
+ * the upper incomplete gamma function.
+ * @param[in] nu: exponent of G.
+ * @param[in] tMax: largest argument that is tabulated.
+ * @return table, NULL if memory allocation fails or the interpolation does not
+ * reach full double precision for this exponent. Has to be freed with free.
+ */
+struct crandallGTable *crandall_gTableCreate(double nu, double tMax);
+
+/**
+ * @brief evaluates the interpolation of exp(t) G(t) in a table.
+ * @param[in] table: table created by crandall_gTableCreate.
+ * @param[in] t: argument with table->tMin <= t <= table->tMax.
+ * @return interpolated value of exp(t) G(t).
+ */
+double crandall_gTableEval(const struct crandallGTable *table, double t);
+
+/**
+ * @brief calculates G for a block of arguments. The asymptotic branch is
+ * vectorized, arguments below zArgBound are interpolated in the table or
+ * evaluated by the upper incomplete gamma function.
+ * @param[in] nu: exponent of the regularized Epstein zeta function.
+ * @param[in] n: number of arguments.
+ * @param[in] zArguments: n values of pi * prefactor ** 2 * z ** 2.
+ * @param[in] zArgBound: bound on when to use the asymptotic expansion.
+ * @param[in] gamma: constants of the upper incomplete gamma function for the
+ * exponent nu / 2 from egf_contextInit.
+ * @param[in] table: table of G for nu from crandall_gTableCreate, or NULL.
+ * @param[out] g: n values of G.
+ */
+void crandall_gBlock(double nu, unsigned int n, const double *zArguments,
+                     double zArgBound, const struct egfContext *gamma,
+                     const struct crandallGTable *table, double *g);
+
+/**
+ * @brief calculates G for a block of arguments in single precision. The
+ * asymptotic expansion and a continued fraction of fixed length are vectorized,
+ * small arguments are evaluated by crandall_gArg.
+ * @param[in] nu: exponent of the regularized Epstein zeta function.
+ * @param[in] n: number of arguments.
+ * @param[in] zArguments: n values of pi * prefactor ** 2 * z ** 2.
+ * @param[in] zArgBound: bound on when to use the asymptotic expansion.
+ * @param[out] g: n values of G.
+ */
+void crandall_gBlockf(float nu, unsigned int n, const float *zArguments,
+                      float zArgBound, float *g);
 #endif
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file crandallq.c
+ * @brief Calculates the summand function G and the regularization of the zero
+ * summand in Crandall's formula in quadruple precision. There is no asymptotic
+ * expansion of G, the incomplete gamma functions are always evaluated to full
+ * precision.
+ */
+
+#include "crandallq.h"
+#include "gammaq.h"
+
+/**
+ * @brief calculates G from the already scaled squared norm of its argument in
+ * quadruple precision.
+ * @param[in] nu: exponent of G.
+ * @param[in] zArgument: pi * prefactor ** 2 * z ** 2
+ * @return upperGamma(nu/2, zArgument) / zArgument^(nu / 2), -2 / nu for
+ * zArgument = 0.
+ */
+__float128 crandall_gq(__float128 nu, __float128 zArgument) {
+    if (zArgument == 0) {
+        return -2 / nu;
+    }
+    return egf_ugammaq(nu / 2, zArgument) / powq(zArgument, nu / 2);
+}
+
+/**
+ * @brief Calculates the regularization of the zero summand in the second sum in
+ * Crandall's formula in quadruple precision.
+ * @param[in] s: dimension minus exponent of the regularized Epstein zeta function,
+ * that is d - nu
+ * @param[in] zArgument: pi * prefactor ** 2 * y ** 2
+ * @param[in] prefactor: prefactor of the vector, e. g. lambda
+ * @return - gamma(s/2) * gammaStar(s/2, zArgument) if s is not equal to - 2k and
+ * zArgument ** k (gamma(-k, zArgument) + ((-1)^k / k!) * (log(zArgument) -
+ * log(prefactor ** 2))) if s is equal to - 2k for a non-negative integer k.
+ */
+__float128 crandall_gRegq(__float128 s, __float128 zArgument,
+                          __float128 prefactor) {
+    int k = -(int)nearbyintq(s / 2);
+    if (s >= 1 || s != -2 * k) {
+        return -tgammaq(s / 2) * egf_gammaStarq(s / 2, zArgument);
+    }
+    // gamma(-k, z) = (-1)^k / k! (E1(z) - exp(-z) sum_{j < k} (-1)^j j! / z^(j+1)),
+    // where E1(z) + log(z) is continuous at z = 0
+    __float128 gReg = powq(zArgument, k) *
+                      (egf_e1Logq(zArgument) - logq(prefactor * prefactor));
+    __float128 poly = 0;
+    __float128 factorial = 1;
+    for (int j = 0; j < k; j++) {
+        poly += factorial * powq(-zArgument, k - 1 - j);
+        factorial *= j + 1;
+    }
+    // factorial = k!, and (-1)^j z^(k - 1 - j) = (-1)^(k - 1) (-z)^(k - 1 - j)
+    gReg -= (k % 2 == 1 ? 1 : -1) * expq(-zArgument) * poly;
+    return (k % 2 == 0 ? 1 : -1) / factorial * gReg;
+}
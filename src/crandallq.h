@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file crandallq.h
+ * @brief Calculates the summand function G and the regularization of the zero
+ * summand in Crandall's formula in quadruple precision.
+ */
+
+#ifndef CRANDALLQ_H
+#define CRANDALLQ_H
+#include <quadmath.h>
+
+/**
+ * @brief calculates G from the already scaled squared norm of its argument in
+ * quadruple precision.
+ * @param[in] nu: exponent of G.
+ * @param[in] zArgument: pi * prefactor ** 2 * z ** 2
+ * @return upperGamma(nu/2, zArgument) / zArgument^(nu / 2), -2 / nu for
+ * zArgument = 0.
+ */
+__float128 crandall_gq(__float128 nu, __float128 zArgument);
+
+/**
+ * @brief Calculates the regularization of the zero summand in the second sum in
+ * Crandall's formula in quadruple precision.
+ * @param[in] s: dimension minus exponent of the regularized Epstein zeta function,
+ * that is d - nu
+ * @param[in] zArgument: pi * prefactor ** 2 * y ** 2
+ * @param[in] prefactor: prefactor of the vector, e. g. lambda
+ * @return - gamma(s/2) * gammaStar(s/2, zArgument) if s is not equal to - 2k and
+ * zArgument ** k (gamma(-k, zArgument) + ((-1)^k / k!) * (log(zArgument) -
+ * log(prefactor ** 2))) if s is equal to - 2k for a non-negative integer k.
+ */
+__float128 crandall_gRegq(__float128 s, __float128 zArgument,
+                          __float128 prefactor);
+#endif
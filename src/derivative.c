@@ -0,0 +1,519 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file derivative.c
+ * @brief Calculates derivatives of the (regularized) Epstein zeta function with
+ * respect to x and y and second derivatives with respect to x. In Crandall's
+ * formula, x and y only enter the arguments of G and the phases of both sums.
+ * With G'_nu(t) = -G_{nu + 2}(t), the gradients and Hessians are sums over the
+ * same lattice points as the function value.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "crandall.h"
+#include "derivative.h"
+#include "lattice.h"
+#include "tools.h"
+#include "zeta.h"
+
+/*!
+ * @brief number of summands for which G is evaluated at once.
+ */
+#define DERIVATIVE_BLOCK 32
+
+/**
+ * @brief counts the sums of derivative_sums.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] order: 1 for the sums of the gradients, 2 for those of the
+ * Hessians.
+ * @return number of sums.
+ */
+unsigned int derivative_nSums(unsigned int dim, unsigned int order) {
+    return order > 1 ? 2 + 2 * dim + 2 * dim * dim : 1 + 2 * dim;
+}
+
+/**
+ * @brief sums G and the lattice points weighted with G and its derivatives for
+ * one of the sums in Crandall's formula in one traversal. With
+ * G'_nu(t) = -G_{nu + 2}(t), these are all sums that the gradients and, for
+ * order 2, the Hessians of the sum need.
+ * @param[in] nu: exponent of G.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase.
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] rows: points v = m zv + shift within the cutoff radius, enumerated
+ * with latticeRowsCreate for the shift.
+ * @param[in] skipZero: true to skip the summand for zv = 0.
+ * @param[in] order: 1 for the sums of the gradients, 2 for those of the
+ * Hessians.
+ * @param[in] zArgBounds: order + 1 bounds on when to use the asymptotic
+ * expansion in G_{nu + 2 k}.
+ * @param[in] gammas: order + 1 constants of the upper incomplete gamma function
+ * for the exponents nu / 2 + k.
+ * @param[out] sums: sum_{zv} G_nu(argScale |v|^2) e, the dim sums
+ * sum_{zv} v G_nu(argScale |v|^2) e and the dim sums
+ * sum_{zv} v G_{nu + 2}(argScale |v|^2) e with the phase
+ * e = exp(-2 * PI * I * (m zv) * w). For order 2, these are followed by
+ * sum_{zv} G_{nu + 2}(argScale |v|^2) e and the dim x dim sums
+ * sum_{zv} v v^T G_nu(argScale |v|^2) e and
+ * sum_{zv} v v^T G_{nu + 4}(argScale |v|^2) e.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int derivative_sums(double nu, unsigned int dim, const double *m,
+                    const double *shift, const double *w, double argScale,
+                    const struct latticeRows *rows, bool skipZero,
+                    unsigned int order, const double *zArgBounds,
+                    const struct egfContext *gammas, double complex *sums) {
+    unsigned int nSums = derivative_nSums(dim, order);
+    double complex epsilons[nSums];
+    double complex terms[nSums];
+    for (int k = 0; k < nSums; k++) {
+        sums[k] = 0;
+        epsilons[k] = 0;
+    }
+    double complex rots[DERIVATIVE_BLOCK];
+    double zArguments[DERIVATIVE_BLOCK];
+    double vs[DERIVATIVE_BLOCK * dim];
+    double gs[3][DERIVATIVE_BLOCK];
+    double complex phases[phaseTableSize(rows)];
+    long offsets[dim];
+    phaseTable(dim, m, w, rows, phases, offsets);
+    struct latticeWalker *walker = latticeWalkerCreate(
+        dim, m, shift, rows, LATTICE_EXACT_ARG / argScale, 0);
+    if (walker == NULL) {
+        return 1;
+    }
+    double complex rotOuter = phaseOuter(dim, walker->zv, rows, phases, offsets);
+    long end = rows->nPoints;
+    for (long block = 0; block < end; block += DERIVATIVE_BLOCK) {
+        unsigned int nBlock = 0;
+        for (long n = block; n < end && n < block + DERIVATIVE_BLOCK; n++) {
+            if (!skipZero || n != rows->zeroIndex) {
+                rots[nBlock] = rotOuter * phases[walker->zv[0] - rows->lower[0]];
+                zArguments[nBlock] = walker->r2 * argScale;
+                // the walker only updates the squared norm, not the point
+                for (int i = 0; i < dim; i++) {
+                    double v = shift[i];
+                    for (int k = 0; k < dim; k++) {
+                        v += m[dim * i + k] * walker->zv[k];
+                    }
+                    vs[dim * nBlock + i] = v;
+                }
+                nBlock++;
+            }
+            if (latticeWalkerNext(walker)) {
+                rotOuter = phaseOuter(dim, walker->zv, rows, phases, offsets);
+            }
+        }
+        crandall_gBlock(nu, nBlock, zArguments, zArgBounds[0], gammas, NULL,
+                        gs[0]);
+        for (int k = 1; k <= order; k++) {
+            double nuK = nu + 2 * (k - 1);
+            if (nuK > 0) {
+                // both terms of the upward recurrence are positive for nu > 0
+                for (unsigned int j = 0; j < nBlock; j++) {
+                    double t = zArguments[j];
+                    gs[k][j] = t < ldexp(1, -62)
+                                   ? -2. / (nuK + 2)
+                                   : (nuK / 2 * gs[k - 1][j] + exp(-t)) / t;
+                }
+            } else {
+                crandall_gBlock(nuK + 2, nBlock, zArguments, zArgBounds[k],
+                                gammas + k, NULL, gs[k]);
+            }
+        }
+        for (unsigned int j = 0; j < nBlock; j++) {
+            const double *v = vs + dim * j;
+            terms[0] = rots[j] * gs[0][j];
+            double complex term2 = rots[j] * gs[1][j];
+            for (int i = 0; i < dim; i++) {
+                terms[1 + i] = terms[0] * v[i];
+                terms[1 + dim + i] = term2 * v[i];
+            }
+            if (order > 1) {
+                double complex term4 = rots[j] * gs[2][j];
+                double complex *vv = terms + 2 + 2 * dim;
+                double complex *vv4 = vv + dim * dim;
+                terms[1 + 2 * dim] = term2;
+                for (int i = 0; i < dim; i++) {
+                    for (int k = 0; k < dim; k++) {
+                        vv[dim * i + k] = terms[1 + i] * v[k];
+                        vv4[dim * i + k] = term4 * v[i] * v[k];
+                    }
+                }
+            }
+            for (int k = 0; k < nSums; k++) {
+                // summing using Kahan's method
+                double complex auxy = terms[k] - epsilons[k];
+                double complex auxt = sums[k] + auxy;
+                epsilons[k] = (auxt - sums[k]) - auxy;
+                sums[k] = auxt;
+            }
+        }
+    }
+    latticeWalkerFree(walker);
+    return 0;
+}
+
+/**
+ * @brief adds the summand of one point w of the second sum in Crandall's formula
+ * to the sums of derivative_sums.
+ * @param[in] nu: exponent of the Epstein zeta function.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] w: shifted point of the reciprocal lattice.
+ * @param[in] x: vector in the phase exp(-2 * PI * I * x * w).
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] zArgBound: bound on when to use the asymptotic expansion.
+ * @param[in] sign: 1 to add the summand, -1 to remove it.
+ * @param[in] order: order of the sums as in derivative_sums.
+ * @param[in, out] sums: sums of derivative_sums for the exponent dim - nu.
+ */
+void derivative_addFourier(double nu, unsigned int dim, const double *w,
+                           const double *x, double argScale, double zArgBound,
+                           double sign, unsigned int order,
+                           double complex *sums) {
+    double t = argScale * dot(dim, w, w);
+    double complex e = sign * cexp(-2 * M_PI * I * dot(dim, x, w));
+    double complex g = crandall_gArg(dim - nu, t, zArgBound) * e;
+    double complex g2 = crandall_gArg(dim - nu + 2, t, zArgBound) * e;
+    sums[0] += g;
+    for (int i = 0; i < dim; i++) {
+        sums[1 + i] += w[i] * g;
+        sums[1 + dim + i] += w[i] * g2;
+    }
+    if (order > 1) {
+        double complex g4 = crandall_gArg(dim - nu + 4, t, zArgBound) * e;
+        double complex *vv = sums + 2 + 2 * dim;
+        double complex *vv4 = vv + dim * dim;
+        sums[1 + 2 * dim] += g2;
+        for (int i = 0; i < dim; i++) {
+            for (int k = 0; k < dim; k++) {
+                vv[dim * i + k] += w[i] * w[k] * g;
+                vv4[dim * i + k] += w[i] * w[k] * g4;
+            }
+        }
+    }
+}
+
+/**
+ * @brief calculates the derivative of the regularized summand for k = 0 in the
+ * second sum in Crandall's formula with respect to its argument. It is
+ * -G_reg_{s + 2}, plus a monomial if s is a non-positive even integer, where the
+ * regularization of G_s subtracts a logarithm instead of a power.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] s: dimension minus exponent of the Epstein zeta function.
+ * @param[in] y: input vector of the summand.
+ * @param[in] lambda: weight of the sums in Crandall's formula.
+ * @return derivative of crandall_gReg(dim, s, y, lambda) with respect to
+ * pi * lambda^2 * y^2.
+ */
+double derivative_gReg(unsigned int dim, double s, const double *y,
+                       double lambda) {
+    double d = -crandall_gReg(dim, s + 2, y, lambda);
+    double k = -(double)nearbyint(s / 2.);
+    if (s < 1 && s == -2 * k && k >= 1) {
+        double t = M_PI * lambda * lambda * dot(dim, y, y);
+        d += pow(-1, k) / tgamma(k + 1) * pow(t, k - 1);
+    }
+    return d;
+}
+
+/**
+ * @brief assembles the (regularized) Epstein Zeta function, its gradients and
+ * optionally its Hessian with respect to x for the lattice of unit volume from
+ * the sums in Crandall's formula.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x_t1: scaled x vector.
+ * @param[in] y_t1: scaled y vector.
+ * @param[in] x_t2: x_t1 projected to the elementary lattice cell.
+ * @param[in] y_t2: y_t1 projected to the elementary reciprocal lattice cell.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[out] res: function value for the lattice of unit volume.
+ * @param[out] gradX: dim derivatives with respect to x_t1.
+ * @param[out] gradY: dim derivatives with respect to y_t1.
+ * @param[out] hessX: dim x dim second derivatives with respect to x_t1, NULL to
+ * only calculate the gradients.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int derivative_crandall(const struct epsteinZetaPlan *plan, const double *x_t1,
+                        const double *y_t1, const double *x_t2,
+                        const double *y_t2, int reg, double complex *res,
+                        double complex *gradX, double complex *gradY,
+                        double complex *hessX) {
+    double nu = plan->nu;
+    unsigned int dim = plan->dim;
+    double lambda = plan->lambda;
+    double zArgBound = plan->zArgBound;
+    double argReal = M_PI / (lambda * lambda);
+    double argFourier = M_PI * lambda * lambda;
+    double shift[dim];
+    for (int i = 0; i < dim; i++) {
+        shift[i] = -x_t2[i];
+    }
+    const double *xf = reg ? x_t1 : x_t2;
+    unsigned int order = hessX == NULL ? 1 : 2;
+    // constants of G_{nu + 2 k} and G_{dim - nu + 2 k}
+    struct egfContext gammasReal[3] = {plan->gammaReal};
+    struct egfContext gammasFourier[3] = {plan->gammaFourier};
+    double boundsReal[3] = {zArgBound};
+    double boundsFourier[3] = {zArgBound};
+    for (int k = 1; k <= order; k++) {
+        egf_contextInit(nu / 2 + k, gammasReal + k);
+        egf_contextInit((dim - nu) / 2 + k, gammasFourier + k);
+        boundsReal[k] = assignzArgBound(nu + 2 * k);
+        boundsFourier[k] = assignzArgBound(dim - nu + 2 * k);
+    }
+    unsigned int nSums = derivative_nSums(dim, order);
+    double complex s1[nSums];
+    double complex s2[nSums];
+    struct latticeRows *rowsReal =
+        latticeRowsCreate(dim, plan->m_real, shift, plan->radiusReal);
+    struct latticeRows *rowsFourier =
+        latticeRowsCreate(dim, plan->m_fourier, y_t2, plan->radiusFourier);
+    bool failed =
+        rowsReal == NULL || rowsFourier == NULL ||
+        derivative_sums(nu, dim, plan->m_real, shift, y_t2, argReal, rowsReal,
+                        false, order, boundsReal, gammasReal, s1) != 0 ||
+        derivative_sums(dim - nu, dim, plan->m_fourier, y_t2, xf, argFourier,
+                        rowsFourier, true, order, boundsFourier, gammasFourier,
+                        s2) != 0;
+    latticeRowsFree(rowsReal);
+    latticeRowsFree(rowsFourier);
+    if (failed) {
+        return 1;
+    }
+    // phases exp(-2 * PI * I * xf * (k + y_t2)) of the second sum
+    double complex rotY = cexp(-2 * M_PI * I * dot(dim, y_t2, xf));
+    for (int k = 0; k < nSums; k++) {
+        s2[k] *= rotY;
+    }
+    double complex *p1 = s1 + 1;
+    double complex *q1 = s1 + 1 + dim;
+    double complex *p2 = s2 + 1;
+    double complex *q2 = s2 + 1 + dim;
+    double vx[dim];
+    for (int i = 0; i < dim; i++) {
+        vx[i] = x_t1[i] - x_t2[i];
+    }
+    double complex xfactor = cexp(-2 * M_PI * I * dot(dim, vx, y_t1));
+    double c = pow(lambda * lambda / M_PI, -nu / 2.) / tgamma(nu / 2.);
+    double lambdaDim = pow(lambda, dim);
+    if (reg) {
+        // the second sum without k = 0 is k + y_t1 != y_t1, where y_t1 may
+        // differ from y_t2
+        if (!equals(dim, y_t1, y_t2)) {
+            derivative_addFourier(nu, dim, y_t2, x_t1, argFourier, zArgBound,
+                                  1, order, s2);
+            derivative_addFourier(nu, dim, y_t1, x_t1, argFourier, zArgBound,
+                                  -1, order, s2);
+        }
+        double complex rot = cexp(2 * M_PI * I * dot(dim, x_t1, y_t1));
+        double gReg = crandall_gReg(dim, dim - nu, y_t1, lambda);
+        double gRegDiff = derivative_gReg(dim, dim - nu, y_t1, lambda);
+        // the regularized summand and the second sum do not have the phase
+        // xfactor of the shifted x
+        double complex c1 = c * xfactor * rot;
+        double c2 = c * lambdaDim;
+        *res = c1 * s1[0] + c2 * (rot * s2[0] + gReg);
+        for (int i = 0; i < dim; i++) {
+            gradX[i] =
+                c1 * (2 * M_PI * I * y_t1[i] * s1[0] + 2 * argReal * q1[i]) -
+                c2 * rot * 2 * M_PI * I * (p2[i] - y_t1[i] * s2[0]);
+            gradY[i] = -c1 * 2 * M_PI * I * p1[i] +
+                       c2 * 2 * argFourier * (y_t1[i] * gRegDiff - rot * q2[i]);
+        }
+        if (hessX != NULL) {
+            // sums of v v^T G_{nu + 4} and of w w^T G_{dim - nu}
+            double complex *t1 = s1 + 2 + 2 * dim + dim * dim;
+            double complex *t2 = s2 + 2 + 2 * dim;
+            for (int i = 0; i < dim; i++) {
+                for (int k = 0; k < dim; k++) {
+                    double complex h1 =
+                        4 * argReal * argReal * t1[dim * i + k] +
+                        4 * M_PI * I * argReal *
+                            (y_t1[i] * q1[k] + y_t1[k] * q1[i]) -
+                        4 * M_PI * M_PI * y_t1[i] * y_t1[k] * s1[0];
+                    double complex h2 = t2[dim * i + k] - y_t1[i] * p2[k] -
+                                        y_t1[k] * p2[i] +
+                                        y_t1[i] * y_t1[k] * s2[0];
+                    if (i == k) {
+                        h1 -= 2 * argReal * s1[1 + 2 * dim];
+                    }
+                    hessX[dim * i + k] =
+                        c1 * h1 - c2 * rot * 4 * M_PI * M_PI * h2;
+                }
+            }
+        }
+    } else {
+        derivative_addFourier(nu, dim, y_t2, x_t2, argFourier, zArgBound, 1,
+                              order, s2);
+        double complex c1 = c * xfactor;
+        *res = c1 * (s1[0] + lambdaDim * s2[0]);
+        for (int i = 0; i < dim; i++) {
+            gradX[i] = c1 * (2 * argReal * q1[i] -
+                             lambdaDim * 2 * M_PI * I * p2[i]);
+            gradY[i] = -c1 * (2 * M_PI * I * (p1[i] + x_t1[i] * s1[0]) +
+                              lambdaDim * (2 * M_PI * I * x_t1[i] * s2[0] +
+                                           2 * argFourier * q2[i]));
+        }
+        if (hessX != NULL) {
+            double complex *t1 = s1 + 2 + 2 * dim + dim * dim;
+            double complex *t2 = s2 + 2 + 2 * dim;
+            for (int i = 0; i < dim; i++) {
+                for (int k = 0; k < dim; k++) {
+                    double complex h =
+                        4 * argReal * argReal * t1[dim * i + k] -
+                        lambdaDim * 4 * M_PI * M_PI * t2[dim * i + k];
+                    if (i == k) {
+                        h -= 2 * argReal * s1[1 + 2 * dim];
+                    }
+                    hessX[dim * i + k] = c1 * h;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function, its gradients and
+ * optionally its Hessian with respect to x from the scaled and projected
+ * vectors.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x_t1: scaled x vector.
+ * @param[in] y_t1: scaled y vector.
+ * @param[in] x_t2: x_t1 projected to the elementary lattice cell.
+ * @param[in] y_t2: y_t1 projected to the elementary reciprocal lattice cell.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[out] gradX: dim derivatives with respect to x.
+ * @param[out] gradY: dim derivatives with respect to y.
+ * @param[out] hessX: dim x dim derivatives with respect to x, NULL to only
+ * calculate the gradients.
+ * @return function value of the (regularized) Epstein zeta, NAN if memory
+ * allocation fails.
+ */
+double complex derivative_execute(const struct epsteinZetaPlan *plan,
+                                  const double *x_t1, const double *y_t1,
+                                  const double *x_t2, const double *y_t2,
+                                  int reg, double complex *gradX,
+                                  double complex *gradY, double complex *hessX) {
+    double nu = plan->nu;
+    unsigned int dim = plan->dim;
+    double ms = plan->ms;
+    double complex res;
+    if (specialCase(nu, dim, x_t1, x_t2, y_t2, reg, &res)) {
+        // the value does not depend on x and on y only by the phase
+        // exp(-2 * PI * I * x_t1 * y_t2) for nu = 0
+        for (int i = 0; i < dim; i++) {
+            gradX[i] = 0 * res;
+            gradY[i] = -2 * M_PI * I * x_t1[i] * res;
+        }
+        for (int k = 0; hessX != NULL && k < dim * dim; k++) {
+            hessX[k] = 0 * res;
+        }
+    } else if (derivative_crandall(plan, x_t1, y_t1, x_t2, y_t2, reg, &res,
+                                   gradX, gradY, hessX) != 0) {
+        for (int i = 0; i < dim; i++) {
+            gradX[i] = gradY[i] = NAN;
+        }
+        for (int k = 0; hessX != NULL && k < dim * dim; k++) {
+            hessX[k] = NAN;
+        }
+        return NAN;
+    }
+    // scaling to the lattice of volume ms^(-dim)
+    for (int i = 0; i < dim; i++) {
+        gradX[i] *= pow(ms, nu + 1);
+        gradY[i] *= pow(ms, nu - 1);
+    }
+    for (int k = 0; hessX != NULL && k < dim * dim; k++) {
+        hessX[k] *= pow(ms, nu + 2);
+    }
+    return pow(ms, nu) * res;
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function, its gradients with
+ * respect to x and y and optionally its Hessian with respect to x from a plan,
+ * with both sums in Crandall's formula and their derivatives from one traversal
+ * of each lattice.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[out] gradX: dim derivatives with respect to x.
+ * @param[out] gradY: dim derivatives with respect to y.
+ * @param[out] hessX: dim x dim derivatives with respect to x, NULL to only
+ * calculate the gradients.
+ * @return function value of the (regularized) Epstein zeta, NAN if memory
+ * allocation fails.
+ */
+double complex epsteinZetaPlanExecuteGradInternal(
+    const struct epsteinZetaPlan *plan, const double *x, const double *y, int reg,
+    double complex *gradX, double complex *gradY, double complex *hessX) {
+    unsigned int dim = plan->dim;
+    double ms = plan->ms;
+    double x_t1[dim];
+    double y_t1[dim];
+    for (int i = 0; i < dim; i++) {
+        x_t1[i] = x[i] * ms;
+        y_t1[i] = y[i] / ms;
+    }
+    double *x_t2 = vectorProj(dim, plan->m_real, plan->m_realInvt, x_t1);
+    double *y_t2 = vectorProj(dim, plan->m_realInvt, plan->m_real, y_t1);
+    double complex res = derivative_execute(plan, x_t1, y_t1, x_t2, y_t2, reg,
+                                            gradX, gradY, hessX);
+    free(x_t2);
+    free(y_t2);
+    return res;
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function, its gradients with
+ * respect to x and y and optionally its Hessian with respect to x.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[out] gradX: dim derivatives with respect to x.
+ * @param[out] gradY: dim derivatives with respect to y.
+ * @param[out] hessX: dim x dim derivatives with respect to x, NULL to only
+ * calculate the gradients.
+ * @return function value of the (regularized) Epstein zeta, NAN if memory
+ * allocation fails.
+ */
+double complex epsteinZetaGradInternal(double nu, unsigned int dim,
+                                       const double *m, const double *x,
+                                       const double *y, int reg,
+                                       double complex *gradX,
+                                       double complex *gradY,
+                                       double complex *hessX) {
+    struct epsteinZetaPlan *plan = epsteinZetaPlanInternal(nu, dim, m, 0, 0);
+    if (plan == NULL) {
+        for (int i = 0; i < dim; i++) {
+            gradX[i] = gradY[i] = NAN;
+        }
+        for (int k = 0; hessX != NULL && k < dim * dim; k++) {
+            hessX[k] = NAN;
+        }
+        return NAN;
+    }
+    double complex res = epsteinZetaPlanExecuteGradInternal(plan, x, y, reg,
+                                                            gradX, gradY, hessX);
+    epsteinZetaPlanFree(plan);
+    return res;
+}
+#undef DERIVATIVE_BLOCK
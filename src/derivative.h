@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file derivative.h
+ * @brief Calculates derivatives of the (regularized) Epstein zeta function with
+ * respect to x and y and second derivatives with respect to x.
+ */
+
+#ifndef DERIVATIVE_H
+#define DERIVATIVE_H
+#include <complex.h>
+#include <stdbool.h>
+
+#include "gamma.h"
+#include "lattice.h"
+#include "zeta.h"
+
+/**
+ * @brief sums G and the lattice points weighted with G and its derivatives for
+ * one of the sums in Crandall's formula in one traversal. With
+ * G'_nu(t) = -G_{nu + 2}(t), these are all sums that the gradients and, for
+ * order 2, the Hessians of the sum need.
+ * @param[in] nu: exponent of G.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase.
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] rows: points v = m zv + shift within the cutoff radius, enumerated
+ * with latticeRowsCreate for the shift.
+ * @param[in] skipZero: true to skip the summand for zv = 0.
+ * @param[in] order: 1 for the sums of the gradients, 2 for those of the
+ * Hessians.
+ * @param[in] zArgBounds: order + 1 bounds on when to use the asymptotic
+ * expansion in G_{nu + 2 k}.
+ * @param[in] gammas: order + 1 constants of the upper incomplete gamma function
+ * for the exponents nu / 2 + k.
+ * @param[out] sums: sum_{zv} G_nu(argScale |v|^2) e, the dim sums
+ * sum_{zv} v G_nu(argScale |v|^2) e and the dim sums
+ * sum_{zv} v G_{nu + 2}(argScale |v|^2) e with the phase
+ * e = exp(-2 * PI * I * (m zv) * w). For order 2, these are followed by
+ * sum_{zv} G_{nu + 2}(argScale |v|^2) e and the dim x dim sums
+ * sum_{zv} v v^T G_nu(argScale |v|^2) e and
+ * sum_{zv} v v^T G_{nu + 4}(argScale |v|^2) e.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int derivative_sums(double nu, unsigned int dim, const double *m,
+                    const double *shift, const double *w, double argScale,
+                    const struct latticeRows *rows, bool skipZero,
+                    unsigned int order, const double *zArgBounds,
+                    const struct egfContext *gammas, double complex *sums);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function, its gradients with
+ * respect to x and y and optionally its Hessian with respect to x from a plan,
+ * with both sums in Crandall's formula and their derivatives from one traversal
+ * of each lattice.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[out] gradX: dim derivatives with respect to x.
+ * @param[out] gradY: dim derivatives with respect to y.
+ * @param[out] hessX: dim x dim derivatives with respect to x, NULL to only
+ * calculate the gradients.
+ * @return function value of the (regularized) Epstein zeta, NAN if memory
+ * allocation fails.
+ */
+double complex epsteinZetaPlanExecuteGradInternal(
+    const struct epsteinZetaPlan *plan, const double *x, const double *y, int reg,
+    double complex *gradX, double complex *gradY, double complex *hessX);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function, its gradients with
+ * respect to x and y and optionally its Hessian with respect to x.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[out] gradX: dim derivatives with respect to x.
+ * @param[out] gradY: dim derivatives with respect to y.
+ * @param[out] hessX: dim x dim derivatives with respect to x, NULL to only
+ * calculate the gradients.
+ * @return function value of the (regularized) Epstein zeta, NAN if memory
+ * allocation fails.
+ */
+double complex epsteinZetaGradInternal(double nu, unsigned int dim,
+                                       const double *m, const double *x,
+                                       const double *y, int reg,
+                                       double complex *gradX,
+                                       double complex *gradY,
+                                       double complex *hessX);
+#endif
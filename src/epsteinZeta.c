@@ -16,10 +16,19 @@
  */
 
 #include <complex.h>
+#include <math.h>
 #include <stdbool.h>
 
+#include "batch.h"
+#include "derivative.h"
 #include "epsteinZeta.h"
+#include "taylor.h"
+#include "threads.h"
 #include "zeta.h"
+#include "zetaf.h"
+#ifdef EPSTEIN_QUAD
+#include "zetaq.h"
+#endif
 
 /**
  * @brief calculates the Epstein Zeta function.
@@ -33,7 +42,7 @@
  */
 double complex epsteinZeta(double nu, unsigned int dim, const double *a,
                            const double *x, const double *y) {
-    return epsteinZetaInternal(nu, dim, a, x, y, 1, false);
+    return epsteinZetaInternal(nu, dim, a, x, y, 0, 0, false);
 }
 
 /**
@@ -48,5 +57,543 @@ double complex epsteinZeta(double nu, unsigned int dim, const double *a,
  */
 double complex epsteinZetaReg(double nu, unsigned int dim, const double *a,
                               const double *x, const double *y) {
-    return epsteinZetaInternal(nu, dim, a, x, y, 1, true);
+    return epsteinZetaInternal(nu, dim, a, x, y, 0, 0, true);
+}
+
+/**
+ * @brief calculates the Epstein Zeta function with the lattice sums in single
+ * precision.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta.
+ */
+float complex epsteinZetaf(float nu, unsigned int dim, const float *a,
+                           const float *x, const float *y) {
+    return epsteinZetaInternalf(nu, dim, a, x, y, false);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function with the lattice sums
+ * in single precision.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta.
+ */
+float complex epsteinZetaRegf(float nu, unsigned int dim, const float *a,
+                              const float *x, const float *y) {
+    return epsteinZetaInternalf(nu, dim, a, x, y, true);
+}
+
+/**
+ * @brief calculates the Epstein Zeta function in quadruple precision.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta, NAN if the library is built
+ * without quadruple precision.
+ */
+double complex epsteinZetaQuad(double nu, unsigned int dim, const double *a,
+                               const double *x, const double *y) {
+#ifdef EPSTEIN_QUAD
+    return epsteinZetaInternalq(nu, dim, a, x, y, false);
+#else
+    return NAN;
+#endif
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function in quadruple
+ * precision.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta, NAN if the library is
+ * built without quadruple precision.
+ */
+double complex epsteinZetaRegQuad(double nu, unsigned int dim, const double *a,
+                                  const double *x, const double *y) {
+#ifdef EPSTEIN_QUAD
+    return epsteinZetaInternalq(nu, dim, a, x, y, true);
+#else
+    return NAN;
+#endif
+}
+
+/**
+ * @brief calculates the Epstein Zeta function with a given weight of the sums
+ * in Crandall's formula.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaLambda(double nu, unsigned int dim, const double *a,
+                                 const double *x, const double *y, double lambda) {
+    return epsteinZetaInternal(nu, dim, a, x, y, lambda, 0, false);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function with a given weight
+ * of the sums in Crandall's formula.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaRegLambda(double nu, unsigned int dim, const double *a,
+                                    const double *x, const double *y,
+                                    double lambda) {
+    return epsteinZetaInternal(nu, dim, a, x, y, lambda, 0, true);
+}
+
+/**
+ * @brief calculates the Epstein Zeta function and its gradients with respect to
+ * x and y.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[out] gradX: derivatives with respect to x.
+ * @param[out] gradY: derivatives with respect to y.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaGrad(double nu, unsigned int dim, const double *a,
+                               const double *x, const double *y,
+                               double complex *gradX, double complex *gradY) {
+    return epsteinZetaGradInternal(nu, dim, a, x, y, false, gradX, gradY,
+                                   NULL);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function and its gradients
+ * with respect to x and y.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[out] gradX: derivatives with respect to x.
+ * @param[out] gradY: derivatives with respect to y.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaRegGrad(double nu, unsigned int dim, const double *a,
+                                  const double *x, const double *y,
+                                  double complex *gradX, double complex *gradY) {
+    return epsteinZetaGradInternal(nu, dim, a, x, y, true, gradX, gradY,
+                                   NULL);
+}
+
+/**
+ * @brief calculates the Epstein Zeta function, its gradient and its Hessian with
+ * respect to x.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[out] gradX: derivatives with respect to x.
+ * @param[out] hessX: second derivatives with respect to x.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaHessian(double nu, unsigned int dim, const double *a,
+                                  const double *x, const double *y,
+                                  double complex *gradX, double complex *hessX) {
+    double complex gradY[dim];
+    return epsteinZetaGradInternal(nu, dim, a, x, y, false, gradX, gradY,
+                                   hessX);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function, its gradient and its
+ * Hessian with respect to x.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[out] gradX: derivatives with respect to x.
+ * @param[out] hessX: second derivatives with respect to x.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaRegHessian(double nu, unsigned int dim,
+                                     const double *a, const double *x,
+                                     const double *y, double complex *gradX,
+                                     double complex *hessX) {
+    double complex gradY[dim];
+    return epsteinZetaGradInternal(nu, dim, a, x, y, true, gradX, gradY, hessX);
+}
+
+/**
+ * @brief calculates the first n Taylor coefficients of the Epstein Zeta function
+ * in nu.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of coefficients.
+ * @param[out] out: n Taylor coefficients in nu.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaTaylorNu(double nu, unsigned int dim, const double *a,
+                        const double *x, const double *y, unsigned int n,
+                        double complex *out) {
+    return epsteinZetaTaylorNuInternal(nu, dim, a, x, y, false, n, out);
+}
+
+/**
+ * @brief calculates the first n Taylor coefficients of the regularized Epstein
+ * Zeta function in nu.
+ * @param[in] nu: exponent for the regularized Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of coefficients.
+ * @param[out] out: n Taylor coefficients in nu.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaRegTaylorNu(double nu, unsigned int dim, const double *a,
+                           const double *x, const double *y, unsigned int n,
+                           double complex *out) {
+    return epsteinZetaTaylorNuInternal(nu, dim, a, x, y, true, n, out);
+}
+
+/**
+ * @brief calculates the Epstein Zeta function up to a tolerance.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaTol(double nu, unsigned int dim, const double *a,
+                              const double *x, const double *y, double tol) {
+    return epsteinZetaInternal(nu, dim, a, x, y, 0, tol, false);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function up to a tolerance.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaRegTol(double nu, unsigned int dim, const double *a,
+                                 const double *x, const double *y, double tol) {
+    return epsteinZetaInternal(nu, dim, a, x, y, 0, tol, true);
+}
+
+/**
+ * @brief precomputes everything that only depends on the exponent and the
+ * lattice.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @return plan for repeated evaluations, NULL if memory allocation fails.
+ */
+epsteinZetaPlan *epsteinZetaPlanCreate(double nu, unsigned int dim,
+                                       const double *a) {
+    return epsteinZetaPlanInternal(nu, dim, a, 0, 0);
+}
+
+/**
+ * @brief precomputes everything that only depends on the exponent, the lattice
+ * and the tolerance.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums.
+ * @return plan for repeated evaluations, NULL if memory allocation fails.
+ */
+epsteinZetaPlan *epsteinZetaPlanCreateTol(double nu, unsigned int dim,
+                                          const double *a, double tol) {
+    return epsteinZetaPlanInternal(nu, dim, a, 0, tol);
+}
+
+/**
+ * @brief precomputes everything that only depends on the exponent, the lattice
+ * and the tolerance, including tables of G for both lattice sums.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums.
+ * @return plan for repeated evaluations, NULL if memory allocation fails.
+ */
+epsteinZetaPlan *epsteinZetaPlanCreateTabulated(double nu, unsigned int dim,
+                                                const double *a, double tol) {
+    epsteinZetaPlan *plan = epsteinZetaPlanInternal(nu, dim, a, 0, tol);
+    if (plan != NULL) {
+        epsteinZetaPlanTabulate(plan);
+    }
+    return plan;
+}
+
+/**
+ * @brief calculates the Epstein Zeta function for a precomputed plan.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta.
+ */
+double complex epsteinZetaPlanExecute(const epsteinZetaPlan *plan, const double *x,
+                                      const double *y) {
+    return epsteinZetaPlanExecuteInternal(plan, x, y, false);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function for a precomputed plan.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaPlanExecuteReg(const epsteinZetaPlan *plan,
+                                         const double *x, const double *y) {
+    return epsteinZetaPlanExecuteInternal(plan, x, y, true);
+}
+
+/**
+ * @brief calculates the Epstein Zeta function for a precomputed plan with the
+ * lattice sums in single precision.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta.
+ */
+float complex epsteinZetaPlanExecutef(const epsteinZetaPlan *plan, const float *x,
+                                      const float *y) {
+    return epsteinZetaPlanExecuteInternalf(plan, x, y, false);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function for a precomputed plan
+ * with the lattice sums in single precision.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta.
+ */
+float complex epsteinZetaPlanExecuteRegf(const epsteinZetaPlan *plan,
+                                         const float *x, const float *y) {
+    return epsteinZetaPlanExecuteInternalf(plan, x, y, true);
+}
+
+/**
+ * @brief calculates the Epstein Zeta function for a precomputed plan in
+ * quadruple precision.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the Epstein zeta, NAN if the library is built
+ * without quadruple precision.
+ */
+double complex epsteinZetaPlanExecuteQuad(const epsteinZetaPlan *plan,
+                                          const double *x, const double *y) {
+#ifdef EPSTEIN_QUAD
+    return epsteinZetaPlanExecuteInternalq(plan, x, y, false);
+#else
+    return NAN;
+#endif
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function for a precomputed plan
+ * in quadruple precision.
+ * @param[in] plan: plan created by epsteinZetaPlanCreate.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return function value of the regularized Epstein zeta, NAN if the library is
+ * built without quadruple precision.
+ */
+double complex epsteinZetaPlanExecuteRegQuad(const epsteinZetaPlan *plan,
+                                             const double *x, const double *y) {
+#ifdef EPSTEIN_QUAD
+    return epsteinZetaPlanExecuteInternalq(plan, x, y, true);
+#else
+    return NAN;
+#endif
+}
+
+/**
+ * @brief frees a plan created by epsteinZetaPlanCreate.
+ * @param[in, out] plan: plan to free, may be NULL.
+ */
+void epsteinZetaPlanDestroy(epsteinZetaPlan *plan) { epsteinZetaPlanFree(plan); }
+
+/**
+ * @brief calculates the Epstein Zeta function for many y vectors and one x
+ * vector.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] ys: n y vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] n: number of y vectors.
+ * @param[out] out: n function values of the Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchY(double nu, unsigned int dim, const double *a, const double *x,
+                      const double *ys, unsigned int n, double complex *out) {
+    return epsteinZetaBatchYInternal(nu, dim, a, x, ys, n, out, 0, false);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function for many y vectors
+ * and one x vector.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] ys: n y vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] n: number of y vectors.
+ * @param[out] out: n function values of the regularized Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaRegBatchY(double nu, unsigned int dim, const double *a,
+                         const double *x, const double *ys, unsigned int n,
+                         double complex *out) {
+    return epsteinZetaBatchYInternal(nu, dim, a, x, ys, n, out, 0, true);
+}
+
+/**
+ * @brief calculates the Epstein Zeta function for many x vectors and one y
+ * vector.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] xs: n x vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of x vectors.
+ * @param[out] out: n function values of the Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchX(double nu, unsigned int dim, const double *a, const double *xs,
+                      const double *y, unsigned int n, double complex *out) {
+    return epsteinZetaBatchXInternal(nu, dim, a, xs, y, n, out, 0, false);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function for many x vectors
+ * and one y vector.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] xs: n x vectors of the Epstein Zeta function, stored one after
+ * another.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of x vectors.
+ * @param[out] out: n function values of the regularized Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaRegBatchX(double nu, unsigned int dim, const double *a,
+                         const double *xs, const double *y, unsigned int n,
+                         double complex *out) {
+    return epsteinZetaBatchXInternal(nu, dim, a, xs, y, n, out, 0, true);
+}
+
+/**
+ * @brief calculates the Epstein Zeta function for many exponents nu.
+ * @param[in] nus: n exponents for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of exponents.
+ * @param[out] out: n function values of the Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchNu(const double *nus, unsigned int dim, const double *a,
+                       const double *x, const double *y, unsigned int n,
+                       double complex *out) {
+    return epsteinZetaBatchNuInternal(nus, dim, a, x, y, n, out, 0, false);
+}
+
+/**
+ * @brief calculates the regularized Epstein Zeta function for many exponents
+ * nu.
+ * @param[in] nus: n exponents for the regularized Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] n: number of exponents.
+ * @param[out] out: n function values of the regularized Epstein zeta.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaRegBatchNu(const double *nus, unsigned int dim, const double *a,
+                          const double *x, const double *y, unsigned int n,
+                          double complex *out) {
+    return epsteinZetaBatchNuInternal(nus, dim, a, x, y, n, out, 0, true);
+}
+
+/**
+ * @brief sets the number of threads used within a single evaluation.
+ * @param[in] n: number of threads, 0 and 1 both disable threading.
+ */
+void epsteinZetaSetNumThreads(unsigned int n) { threadsSetNum(n); }
+
+/**
+ * @brief gets the number of threads used within a single evaluation.
+ * @return number of threads, at least 1.
+ */
+unsigned int epsteinZetaGetNumThreads(void) { return threadsGetNum(); }
+
+/**
+ * @brief evaluates many independent (regularized) Epstein zeta functions on a
+ * work-stealing pool.
+ * @param[in, out] tasks: n evaluations, their result is set on return.
+ * @param[in] n: number of evaluations.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaBatchTasks(epsteinZetaTask *tasks, unsigned int n) {
+    return epsteinZetaBatchTasksInternal(tasks, n, 0);
 }
@@ -23,6 +23,11 @@ Incomplete Gamma Func-257 tions”. In: ACM Trans. Math. Softw. 5 (1979), pp.
  * @brief epsilon for cutoff around integers.
  */
 #define EGF_EPS ldexp(1, -54)
+/*!
+ * @brief maximal number of arguments that are handled at once by the block
+ * versions of the algorithms.
+ */
+#define EGF_BLOCK 256
 /*!
  * @brief enum for the choice of algorithm for the upper incomplete gamma
  * function.
@@ -103,12 +108,12 @@ double egf_pt(double a, double x) {
 }
 
 /**
- * @brief calculate the upper incomplete gamma function as in Gautschi.
+ * @brief Taylor series of g(a) = (1 / gamma(1 + a) - 1) / a for |a| < 0.5, as
+ * used in the algorithm of Gautschi.
  * @param[in] a: exponent of the upper incomplete gamma function.
- * @param[in] x: lower integral boundary of the upper incomplete gamma function.
- * @return function value of the upper incomplete gamma function.
+ * @return g(a)
  */
-double egf_qt(double a, double x) {
+double egf_qt_g(double a) {
     static double taylor[21] = {
         -0.57721566490153286061,    0.078662406618721020471,
         0.120665041652816256,       -0.045873569729475233502,
@@ -121,17 +126,41 @@ double egf_qt(double a, double x) {
         1.0891334567503768218e-10,  4.5706745059276311356e-12,
         -3.2115889339774401184e-12, 4.8521668466476558978e-13,
         -2.4820344080682008122e-14};
-    double u;
+    double u1 = taylor[0];
+    double f = 1;
+    for (int i = 1; i < 21; i++) {
+        f *= a;
+        u1 += taylor[i] * f;
+    }
+    return u1;
+}
+
+/**
+ * @brief calculate the constant in the first part of the upper incomplete gamma
+ * function as in Gautschi, it only depends on a.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @return gamma(1 + a) * (1 - a) * g(a) for |a| < 0.5, else gamma(a).
+ */
+double egf_qt_c(double a) {
+    if (fabs(a) < 0.5) {
+        return tgamma(1 + a) * (1 - a) * egf_qt_g(a);
+    }
+    return tgamma(a);
+}
+
+/**
+ * @brief calculate the first part u of the upper incomplete gamma function as
+ * in Gautschi.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[in] x: lower integral boundary of the upper incomplete gamma function.
+ * @param[in] c: constant from egf_qt_c(a).
+ * @return u = gamma(a) - x ** a / a
+ */
+double egf_qt_u(double a, double x, double c) {
     if (fabs(a) < 0.5) {
-        double u1 = taylor[0];
-        double f = 1;
-        for (int i = 1; i < 21; i++) {
-            f *= a;
-            u1 += taylor[i] * f;
-        } // u1 = g(a)
         double u2 = 0;
         double y = a * log(x);
-        f = 1;
+        double f = 1;
         if (fabs(y) < 1) {
             for (int n = 1; n <= 30; n++) {
                 f /= (double)n;
@@ -141,10 +170,19 @@ double egf_qt(double a, double x) {
         } else {
             u2 = (exp(y) - 1) / y;
         }
-        u = tgamma(1 + a) * (1 - a) * u1 - u2 * log(x);
-    } else {
-        u = tgamma(a) - pow(x, a) / a;
+        return c - u2 * log(x);
     }
+    return c - pow(x, a) / a;
+}
+
+/**
+ * @brief calculate the upper incomplete gamma function as in Gautschi.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[in] x: lower integral boundary of the upper incomplete gamma function.
+ * @return function value of the upper incomplete gamma function.
+ */
+double egf_qt(double a, double x) {
+    double u = egf_qt_u(a, x, egf_qt_c(a));
     double v = 0;
     double f = 1;
     for (int i = 1; i <= 30; i++) {
@@ -193,12 +231,12 @@ double egf_cf(double a, double x) {
 }
 
 /**
- * @brief calculate the upper incomplete gamma function as in Gautschi.
+ * @brief calculate the coefficients of the uniform asymptotic expansion of the
+ * upper incomplete gamma function as in Gautschi, they only depend on a.
  * @param[in] a: exponent of the upper incomplete gamma function.
- * @param[in] x: lower integral boundary of the upper incomplete gamma function.
- * @return function value of the upper incomplete gamma function.
+ * @param[out] beta: 26 coefficients of the expansion in eta.
  */
-double egf_ua_r(double a, double eta) {
+void egf_ua_beta(double a, double *beta) {
     static double d[27] = {1.0,
                            -1.0 / 3.0,
                            1.0 / 12.0,
@@ -226,12 +264,23 @@ double egf_ua_r(double a, double eta) {
                            -5.13911183424257258e-16,
                            -1.97522882943494428e-15,
                            8.09952115670456133e-16};
-    double beta[26];
     beta[25] = d[26];
     beta[24] = d[25];
     for (int n = 23; n >= 0; n--) {
         beta[n] = (double)(n + 2) * beta[n + 2] / a + d[n + 1];
     }
+}
+
+/**
+ * @brief calculate the remainder in the uniform asymptotic expansion of the
+ * upper incomplete gamma function as in Gautschi.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[in] eta: transformed lower integral boundary.
+ * @return remainder of the uniform asymptotic expansion.
+ */
+double egf_ua_r(double a, double eta) {
+    double beta[26];
+    egf_ua_beta(a, beta);
     double s = 0;
     double f = 1.;
     for (int i = 0; i <= 25; i++) {
@@ -327,4 +376,297 @@ double egf_gammaStar(double a, double x) {
     }
     return r;
 }
+
+/**
+ * @brief precomputes the constants of the upper incomplete gamma function for
+ * one exponent, which the block versions of the algorithms would otherwise
+ * recompute with several calls of tgamma for every block. The constants of an
+ * algorithm are only computed if its domain contains arguments for this a.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[out] ctx: constants for egf_ugamma_batchContext.
+ */
+void egf_contextInit(double a, struct egfContext *ctx) {
+    ctx->a = a;
+    ctx->gammaA = NAN;
+    ctx->gammaA1 = NAN;
+    ctx->qtC = NAN;
+    ctx->rekM = 0;
+    ctx->rekEpsilon = a;
+    ctx->rekC = NAN;
+    for (int i = 0; i < 26; i++) {
+        ctx->uaBeta[i] = NAN;
+    }
+    // pt and ua need a > alpha > 0 or a >= 12, rek and qt need x <= 1.5
+    if (a > 0) {
+        ctx->gammaA = tgamma(a);
+        ctx->gammaA1 = tgamma(a + 1);
+    }
+    if (a >= -0.5) {
+        ctx->qtC = egf_qt_c(a);
+    }
+    if (a < 0.5) {
+        ctx->rekM = (int)(0.5 - a);
+        ctx->rekEpsilon = a + ctx->rekM;
+        ctx->rekC = egf_qt_c(ctx->rekEpsilon);
+    }
+    if (a >= 12) {
+        egf_ua_beta(a, ctx->uaBeta);
+    }
+}
+
+/**
+ * @brief block version of egf_pt. Each lane stops adding terms exactly where
+ * egf_pt does, so the results agree bit for bit. Instead of branching, a lane
+ * adds its term multiplied by an activity mask of 0 or 1, which is exact, and
+ * convergence of the whole block is only checked every 8 terms, such that the
+ * inner loop over the lanes can be vectorized.
+ * @param[in] ctx: constants of the exponent a from egf_contextInit.
+ * @param[in] n: number of arguments, at most EGF_BLOCK.
+ * @param[in] x: n lower integral boundaries.
+ * @param[out] r: n values of egf_pt(a, x).
+ */
+void egf_pt_block(const struct egfContext *ctx, unsigned int n, const double *x,
+                  double *r) {
+    double a = ctx->a;
+    double sn[EGF_BLOCK];
+    double add[EGF_BLOCK];
+    double active[EGF_BLOCK];
+    for (unsigned int l = 0; l < n; l++) {
+        sn[l] = 1;
+        add[l] = x[l] / (a + 1);
+        active[l] = 1;
+    }
+    for (int i = 1; i < 80; i += 8) {
+        for (int j = i; j < i + 8 && j < 80; j++) {
+            for (unsigned int l = 0; l < n; l++) {
+                active[l] *= (double)(fabs(add[l] / sn[l]) >= EGF_EPS);
+                sn[l] += active[l] * add[l];
+                add[l] *= (x[l] / (a + j + 1));
+            }
+        }
+        double any = 0;
+        for (unsigned int l = 0; l < n; l++) {
+            any += active[l];
+        }
+        if (any == 0) {
+            break;
+        }
+    }
+    for (unsigned int l = 0; l < n; l++) {
+        r[l] = sn[l] * exp(-x[l]) / ctx->gammaA1;
+    }
+}
+
+/**
+ * @brief block version of egf_qt with the precomputed constant egf_qt_c(a).
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[in] c: constant egf_qt_c(a).
+ * @param[in] n: number of arguments, at most EGF_BLOCK.
+ * @param[in] x: n lower integral boundaries.
+ * @param[out] r: n values of egf_qt(a, x).
+ */
+void egf_qt_block(double a, double c, unsigned int n, const double *x,
+                  double *r) {
+    double v[EGF_BLOCK];
+    double f[EGF_BLOCK];
+    for (unsigned int l = 0; l < n; l++) {
+        v[l] = 0;
+        f[l] = 1;
+    }
+    for (int i = 1; i <= 30; i++) {
+        for (unsigned int l = 0; l < n; l++) {
+            f[l] *= (-1) * x[l] / (double)i;
+            v[l] += f[l] / (double)(a + i);
+        }
+    }
+    for (unsigned int l = 0; l < n; l++) {
+        v[l] *= -pow(x[l], a);
+        r[l] = egf_qt_u(a, x[l], c) + v[l];
+    }
+}
+
+/**
+ * @brief block version of egf_rek.
+ * @param[in] ctx: constants of the exponent a from egf_contextInit.
+ * @param[in] n: number of arguments, at most EGF_BLOCK.
+ * @param[in] x: n lower integral boundaries.
+ * @param[out] r: n values of egf_rek(a, x).
+ */
+void egf_rek_block(const struct egfContext *ctx, unsigned int n, const double *x,
+                   double *r) {
+    int m = ctx->rekM;
+    double epsilon = ctx->rekEpsilon;
+    egf_qt_block(epsilon, ctx->rekC, n, x, r);
+    for (unsigned int l = 0; l < n; l++) {
+        r[l] = r[l] * exp(x[l]) * pow(x[l], -epsilon);
+    }
+    for (int k = 1; k <= m; k++) {
+        for (unsigned int l = 0; l < n; l++) {
+            r[l] = 1. / (k - epsilon) * (1. - x[l] * r[l]);
+        }
+    }
+}
+
+/**
+ * @brief block version of egf_cf. Each lane stops adding terms at the same term
+ * as egf_cf, masked as in egf_pt_block, and convergence of the whole block is
+ * only checked every 8 terms.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[in] n: number of arguments, at most EGF_BLOCK.
+ * @param[in] x: n lower integral boundaries.
+ * @param[out] r: n values of egf_cf(a, x).
+ */
+void egf_cf_block(double a, unsigned int n, const double *x, double *r) {
+    double s[EGF_BLOCK];
+    double rp[EGF_BLOCK];
+    double rv[EGF_BLOCK];
+    double active[EGF_BLOCK];
+    for (unsigned int l = 0; l < n; l++) {
+        s[l] = 1;
+        rp[l] = 1;
+        rv[l] = 0;
+        active[l] = 1;
+    }
+    for (int k0 = 1; k0 <= 200; k0 += 8) {
+        for (int k = k0; k < k0 + 8 && k <= 200; k++) {
+            for (unsigned int l = 0; l < n; l++) {
+                active[l] *= (double)(fabs(rp[l] / s[l]) >= EGF_EPS);
+                double ak = k * (a - k) / (double)((x[l] + 2 * k - 1 - a) *
+                                                   (x[l] + 2 * k + 1 - a));
+                rv[l] = -ak * (1 + rv[l]) / (1 + ak * (1 + rv[l]));
+                rp[l] *= rv[l];
+                s[l] += active[l] * rp[l];
+            }
+        }
+        double any = 0;
+        for (unsigned int l = 0; l < n; l++) {
+            any += active[l];
+        }
+        if (any == 0) {
+            break;
+        }
+    }
+    for (unsigned int l = 0; l < n; l++) {
+        r[l] = s[l] * pow(x[l], a) * exp(-x[l]) / (x[l] + 1 - a);
+    }
+}
+
+/**
+ * @brief block version of egf_ua with the precomputed coefficients of the
+ * expansion.
+ * @param[in] ctx: constants of the exponent a from egf_contextInit.
+ * @param[in] n: number of arguments, at most EGF_BLOCK.
+ * @param[in] x: n lower integral boundaries.
+ * @param[out] r: n values of egf_ua(a, x).
+ */
+void egf_ua_block(const struct egfContext *ctx, unsigned int n, const double *x,
+                  double *r) {
+    double a = ctx->a;
+    const double *beta = ctx->uaBeta;
+    double eta[EGF_BLOCK];
+    double s[EGF_BLOCK];
+    double f[EGF_BLOCK];
+    for (unsigned int l = 0; l < n; l++) {
+        double lambda = x[l] / a;
+        eta[l] = sqrt(2 * (lambda - 1 - log(lambda)));
+        if (lambda - 1 < 0) {
+            eta[l] = -eta[l];
+        }
+        s[l] = 0;
+        f[l] = 1.;
+    }
+    for (int i = 0; i <= 25; i++) {
+        for (unsigned int l = 0; l < n; l++) {
+            s[l] += beta[i] * f[l];
+            f[l] *= eta[l];
+        }
+    }
+    double norm = sqrt(2 * M_PI * a);
+    for (unsigned int l = 0; l < n; l++) {
+        s[l] *= a / (a + beta[1]);
+        double ra = s[l] * exp(-0.5 * a * eta[l] * eta[l]) / norm;
+        r[l] = 0.5 * erfc(eta[l] * sqrt(a / 2.)) + ra;
+    }
+}
+
+/**
+ * @brief calculate the upper incomplete gamma function for many arguments and
+ * one exponent. The arguments are partitioned by the domain of the algorithm,
+ * and each algorithm runs as a block over all arguments of its domain, sharing
+ * the constants that only depend on a.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[in] xs: n lower integral boundaries.
+ * @param[in] n: number of arguments.
+ * @param[out] out: n function values of the upper incomplete gamma function,
+ * equal to egf_ugamma(a, xs[i]).
+ */
+void egf_ugamma_batch(double a, const double *xs, unsigned int n, double *out) {
+    struct egfContext ctx;
+    egf_contextInit(a, &ctx);
+    egf_ugamma_batchContext(&ctx, xs, n, out);
+}
+
+/**
+ * @brief calculate the upper incomplete gamma function for many arguments and
+ * one exponent with precomputed constants, see egf_ugamma_batch.
+ * @param[in] ctx: constants of the exponent from egf_contextInit.
+ * @param[in] xs: n lower integral boundaries.
+ * @param[in] n: number of arguments.
+ * @param[out] out: n function values of the upper incomplete gamma function,
+ * equal to egf_ugamma(ctx->a, xs[i]).
+ */
+void egf_ugamma_batchContext(const struct egfContext *ctx, const double *xs,
+                             unsigned int n, double *out) {
+    unsigned int idx[5][EGF_BLOCK];
+    double xb[EGF_BLOCK];
+    double rb[EGF_BLOCK];
+    double a = ctx->a;
+    double ga = ctx->gammaA;
+    for (unsigned int start = 0; start < n; start += EGF_BLOCK) {
+        unsigned int count[5] = {0, 0, 0, 0, 0};
+        for (unsigned int i = start; i < n && i < start + EGF_BLOCK; i++) {
+            enum dom g = egf_domain(a, xs[i]);
+            idx[g][count[g]++] = i;
+        }
+        for (enum dom g = pt; g <= rek; g++) {
+            unsigned int m = count[g];
+            if (m == 0) {
+                continue;
+            }
+            for (unsigned int l = 0; l < m; l++) {
+                xb[l] = xs[idx[g][l]];
+            }
+            switch (g) {
+            case pt:
+                egf_pt_block(ctx, m, xb, rb);
+                for (unsigned int l = 0; l < m; l++) {
+                    rb[l] = ga * (1 - rb[l] * pow(xb[l], a));
+                }
+                break;
+            case qt:
+                egf_qt_block(a, ctx->qtC, m, xb, rb);
+                break;
+            case cf:
+                egf_cf_block(a, m, xb, rb);
+                break;
+            case ua:
+                egf_ua_block(ctx, m, xb, rb);
+                for (unsigned int l = 0; l < m; l++) {
+                    rb[l] = ga * rb[l];
+                }
+                break;
+            case rek:
+                egf_rek_block(ctx, m, xb, rb);
+                for (unsigned int l = 0; l < m; l++) {
+                    rb[l] = exp(-xb[l]) * pow(xb[l], a) * rb[l];
+                }
+                break;
+            }
+            for (unsigned int l = 0; l < m; l++) {
+                out[idx[g][l]] = rb[l];
+            }
+        }
+    }
+}
+#undef EGF_BLOCK
 #undef EGF_EPS
@@ -19,6 +19,30 @@ Incomplete Gamma Func-257 tions”. In: ACM Trans. Math. Softw. 5 (1979), pp.
 
 #ifndef GAMMA_H
 #define GAMMA_H
+
+/**
+ * @brief constants of the algorithms for the upper incomplete gamma function
+ * that only depend on the exponent a, computed once by egf_contextInit.
+ */
+struct egfContext {
+    double a;          //!< exponent of the upper incomplete gamma function.
+    double gammaA;     //!< gamma(a), for the series and the uniform expansion.
+    double gammaA1;    //!< gamma(a + 1), the norm of the series in egf_pt.
+    double qtC;        //!< egf_qt_c(a), constant of the series for small x.
+    int rekM;          //!< number of steps of the recursion in egf_rek.
+    double rekEpsilon; //!< exponent a + rekM that the recursion starts from.
+    double rekC;       //!< egf_qt_c(rekEpsilon).
+    double uaBeta[26]; //!< coefficients of the uniform asymptotic expansion.
+};
+
+/**
+ * @brief precomputes the constants of the upper incomplete gamma function for
+ * one exponent.
+ * @param a: exponent of the upper incomplete gamma function.
+ * @param ctx: constants for egf_ugamma_batchContext.
+ */
+void egf_contextInit(double a, struct egfContext *ctx);
+
 /**
  * @brief calculate the upper incomplete gamma function as in Gautschi.
  * @param a: exponent of the upper incomplete gamma function.
@@ -33,4 +57,23 @@ double egf_ugamma(double a, double x);
  * @return function value of the upper incomplete gamma function.
  */
 double egf_gammaStar(double a, double x);
+/**
+ * @brief calculate the upper incomplete gamma function for many arguments and
+ * one exponent, with the arguments partitioned by algorithm.
+ * @param a: exponent of the upper incomplete gamma function.
+ * @param xs: n lower integral boundaries.
+ * @param n: number of arguments.
+ * @param out: n function values of the upper incomplete gamma function.
+ */
+void egf_ugamma_batch(double a, const double *xs, unsigned int n, double *out);
+/**
+ * @brief calculate the upper incomplete gamma function for many arguments and
+ * one exponent with precomputed constants, see egf_ugamma_batch.
+ * @param ctx: constants of the exponent from egf_contextInit.
+ * @param xs: n lower integral boundaries.
+ * @param n: number of arguments.
+ * @param out: n function values of the upper incomplete gamma function.
+ */
+void egf_ugamma_batchContext(const struct egfContext *ctx, const double *xs,
+                             unsigned int n, double *out);
 #endif
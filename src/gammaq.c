@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file gammaq.c
+ * @brief Gamma functions in quadruple precision.
+ *
+ * Calculates the upper incomplete gamma function and the twice regularized lower
+ * incomplete gamma function with __float128. The algorithms follow the domains
+ * of Gautschi, but the truncations adapt to the precision instead of being tuned
+ * for double precision: a continued fraction for large arguments, the series of
+ * the lower incomplete gamma function for large exponents and the series of
+ * Gautschi for small exponents, followed by the downward recursion.
+ */
+
+#include "gammaq.h"
+#include <stdbool.h>
+
+/*!
+ * @brief maximal number of terms of the series and continued fractions.
+ */
+#define EGFQ_MAX_TERMS 4000
+
+/*!
+ * @brief Euler's constant in quadruple precision.
+ */
+#define EGFQ_EULER 0.5772156649015328606065120900824024310Q
+
+/**
+ * @brief calculate the series of the twice regularized lower incomplete gamma
+ * function in quadruple precision.
+ * @param[in] a: exponent of the lower incomplete gamma function.
+ * @param[in] x: upper integral boundary of the lower incomplete gamma function.
+ * @return exp(-x) * sum_n x^n / gamma(a + n + 1)
+ */
+__float128 egf_seriesq(__float128 a, __float128 x) {
+    bool pole = a + 1 <= 0 && a == floorq(a);
+    if (x == 0) {
+        return pole ? 0 : 1 / tgammaq(a + 1);
+    }
+    // the terms before the first index n0 with a + n0 + 1 > 0 follow from the
+    // backward recursion, which vanishes at the poles of gamma
+    int n0 = a + 1 > 0 ? 0 : (int)floorq(-a - 1) + 1;
+    __float128 t0 = powq(x, n0) / tgammaq(a + n0 + 1);
+    __float128 sum = t0;
+    __float128 t = t0;
+    for (int n = n0 + 1;
+         n < EGFQ_MAX_TERMS && fabsq(t) > FLT128_EPSILON * fabsq(sum); n++) {
+        t *= x / (a + n);
+        sum += t;
+    }
+    t = t0;
+    for (int n = n0; n > 0; n--) {
+        t *= (a + n) / x;
+        sum += t;
+    }
+    return expq(-x) * sum;
+}
+
+/**
+ * @brief calculate the continued fraction of the upper incomplete gamma function
+ * with the modified algorithm of Lentz in quadruple precision.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[in] x: lower integral boundary of the upper incomplete gamma function.
+ * @return upperGamma(a, x) * exp(x) * x^(-a)
+ */
+__float128 egf_cfq(__float128 a, __float128 x) {
+    __float128 tiny = FLT128_MIN / FLT128_EPSILON;
+    __float128 b = x + 1 - a;
+    __float128 c = 1 / tiny;
+    __float128 d = 1 / b;
+    __float128 h = d;
+    for (int k = 1; k < EGFQ_MAX_TERMS; k++) {
+        __float128 an = -k * (k - a);
+        b += 2;
+        d = an * d + b;
+        d = fabsq(d) < tiny ? tiny : d;
+        c = b + an / c;
+        c = fabsq(c) < tiny ? tiny : c;
+        d = 1 / d;
+        __float128 delta = d * c;
+        h *= delta;
+        if (fabsq(delta - 1) <= FLT128_EPSILON) {
+            break;
+        }
+    }
+    return h;
+}
+
+/**
+ * @brief calculate (gamma(1 + eps) - 1) / eps in quadruple precision without
+ * cancellation for small eps. For |eps| < 2^(-10), log(gamma(1 + eps)) is the
+ * Taylor series -euler * eps + sum_k (-1)^k zeta(k) / k * eps^k.
+ * @param[in] eps: argument, |eps| <= 0.5 and eps != 0.
+ * @return (gamma(1 + eps) - 1) / eps
+ */
+__float128 egf_gamma1pm1q(__float128 eps) {
+    static const __float128 taylor[13] = {
+        -0.577215664901532860606512090082402431Q,
+        0.8224670334241132182362075833230125946Q,
+        -0.4006856343865314284665793871704833303Q,
+        0.2705808084277845478790009241352919757Q,
+        -0.2073855510286739852662730972914068336Q,
+        0.1695571769974081899524196549651534213Q,
+        -0.1440498967688461181199710785499709657Q,
+        0.1255096695247430424223356548135815582Q,
+        -0.1113342658695646904908725299147124512Q,
+        0.1000994575127818085337145958900319017Q,
+        -0.09095401714582904223260929841149726695Q,
+        0.08335384054610900402488649983731163925Q,
+        -0.07693251641135219147282706434818133813Q};
+    __float128 lgamma1p = lgammaq(1 + eps);
+    if (fabsq(eps) < 0x1p-10Q) {
+        __float128 g = taylor[12];
+        for (int k = 11; k >= 0; k--) {
+            g = g * eps + taylor[k];
+        }
+        lgamma1p = g * eps;
+    }
+    return expm1q(lgamma1p) / eps;
+}
+
+/**
+ * @brief calculate the series in the upper incomplete gamma function for small
+ * exponents in quadruple precision as in Gautschi.
+ * @param[in] eps: exponent of the upper incomplete gamma function, |eps| <= 0.5.
+ * @param[in] x: lower integral boundary of the upper incomplete gamma function.
+ * @return sum_{n >= 1} (-x)^n / (n! (eps + n))
+ */
+__float128 egf_smallSeriesq(__float128 eps, __float128 x) {
+    __float128 v = 0;
+    __float128 f = 1;
+    for (int n = 1; n < EGFQ_MAX_TERMS; n++) {
+        f *= -x / n;
+        __float128 term = f / (eps + n);
+        v += term;
+        if (fabsq(term) <= FLT128_EPSILON * fabsq(v)) {
+            break;
+        }
+    }
+    return v;
+}
+
+/**
+ * @brief calculate the upper incomplete gamma function for small exponents in
+ * quadruple precision as in Gautschi.
+ * @param[in] eps: exponent of the upper incomplete gamma function, |eps| <= 0.5.
+ * @param[in] x: lower integral boundary of the upper incomplete gamma function.
+ * @return function value of the upper incomplete gamma function.
+ */
+__float128 egf_smallq(__float128 eps, __float128 x) {
+    __float128 logx = logq(x);
+    // u = gamma(eps) - x^eps / eps, without cancellation for small eps
+    __float128 u = -EGFQ_EULER - logx;
+    if (eps != 0) {
+        u = egf_gamma1pm1q(eps) - expm1q(eps * logx) / eps;
+    }
+    return u - expq(eps * logx) * egf_smallSeriesq(eps, x);
+}
+
+/**
+ * @brief calculate the upper incomplete gamma function in quadruple precision.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[in] x: lower integral boundary of the upper incomplete gamma function,
+ * x > 0.
+ * @return function value of the upper incomplete gamma function.
+ */
+__float128 egf_ugammaq(__float128 a, __float128 x) {
+    if (x > 2 && x > a) {
+        return expq(a * logq(x) - x) * egf_cfq(a, x);
+    }
+    if (a >= 0.5Q) {
+        return tgammaq(a) * (1 - expq(a * logq(x)) * egf_seriesq(a, x));
+    }
+    // downward recursion from an exponent in [-0.5, 0.5], which is stable for
+    // small x, as x^s exp(-x) dominates the upper incomplete gamma function
+    int m = (int)nearbyintq(-a);
+    __float128 eps = a + m;
+    __float128 g = egf_smallq(eps, x);
+    for (int j = 1; j <= m; j++) {
+        __float128 s = eps - j;
+        g = (g - expq(s * logq(x) - x)) / s;
+    }
+    return g;
+}
+
+/**
+ * @brief calculate the twice regularized lower incomplete gamma function
+ * x^(-a) * lowerGamma(a, x) / gamma(a) in quadruple precision.
+ * @param[in] a: exponent of the lower incomplete gamma function.
+ * @param[in] x: upper integral boundary of the lower incomplete gamma function,
+ * x >= 0.
+ * @return function value of the twice regularized lower incomplete gamma
+ * function, which is entire in a.
+ */
+__float128 egf_gammaStarq(__float128 a, __float128 x) {
+    if (x > 2 && x > a) {
+        if (a <= 0 && a == floorq(a)) {
+            return expq(-a * logq(x));
+        }
+        return expq(-a * logq(x)) * (1 - egf_ugammaq(a, x) / tgammaq(a));
+    }
+    return egf_seriesq(a, x);
+}
+
+/**
+ * @brief calculate the exponential integral E1(x) = upperGamma(0, x) plus log(x)
+ * in quadruple precision, which is continuous at x = 0.
+ * @param[in] x: lower integral boundary of the upper incomplete gamma function,
+ * x >= 0.
+ * @return upperGamma(0, x) + log(x), -euler for x = 0.
+ */
+__float128 egf_e1Logq(__float128 x) {
+    if (x > 2) {
+        return egf_ugammaq(0, x) + logq(x);
+    }
+    return -EGFQ_EULER - egf_smallSeriesq(0, x);
+}
+#undef EGFQ_MAX_TERMS
+#undef EGFQ_EULER
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file gammaq.h
+ * @brief Gamma functions in quadruple precision.
+ *
+ * Calculates the upper incomplete gamma function and the twice regularized lower
+ * incomplete gamma function with __float128 for the extended precision
+ * evaluation of Crandall's formula.
+ */
+
+#ifndef GAMMAQ_H
+#define GAMMAQ_H
+#include <quadmath.h>
+
+/**
+ * @brief calculate the upper incomplete gamma function in quadruple precision.
+ * @param[in] a: exponent of the upper incomplete gamma function.
+ * @param[in] x: lower integral boundary of the upper incomplete gamma function,
+ * x > 0.
+ * @return function value of the upper incomplete gamma function.
+ */
+__float128 egf_ugammaq(__float128 a, __float128 x);
+
+/**
+ * @brief calculate the twice regularized lower incomplete gamma function
+ * x^(-a) * lowerGamma(a, x) / gamma(a) in quadruple precision.
+ * @param[in] a: exponent of the lower incomplete gamma function.
+ * @param[in] x: upper integral boundary of the lower incomplete gamma function,
+ * x >= 0.
+ * @return function value of the twice regularized lower incomplete gamma
+ * function, which is entire in a.
+ */
+__float128 egf_gammaStarq(__float128 a, __float128 x);
+
+/**
+ * @brief calculate the exponential integral E1(x) = upperGamma(0, x) plus log(x)
+ * in quadruple precision, which is continuous at x = 0.
+ * @param[in] x: lower integral boundary of the upper incomplete gamma function,
+ * x >= 0.
+ * @return upperGamma(0, x) + log(x), -euler for x = 0.
+ */
+__float128 egf_e1Logq(__float128 x);
+#endif
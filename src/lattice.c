@@ -0,0 +1,548 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file lattice.c
+ * @brief Enumeration of the lattice points in the sums of Crandall's formula.
+ */
+
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tools.h"
+
+#include "lattice.h"
+
+/*!
+ * @brief parameter of the Lovasz condition in the basis reduction.
+ */
+#define LLL_DELTA 0.99
+
+/*!
+ * @brief maximal number of steps of the basis reduction per squared dimension,
+ * which guards against cycling due to rounding errors.
+ */
+#define LLL_MAX_STEPS 1000
+
+/**
+ * @brief reduces the basis of a lattice with the algorithm of Lenstra, Lenstra
+ * and Lovasz, such that skewed bases of the same lattice lead to similar
+ * enumerations.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix whose columns are the basis vectors.
+ * @param[out] u: unimodular integer matrix, such that the columns of m u are an
+ * LLL-reduced basis of the same lattice. The identity if m is already reduced.
+ */
+void latticeReduce(unsigned int dim, const double *m, double *u) {
+    // basis vectors b[k] as rows, their Gram-Schmidt orthogonalization bs[k],
+    // the coefficients mu[k][j] and the squared norms norms[k] of bs[k]
+    double b[dim * dim];
+    double bs[dim * dim];
+    double mu[dim * dim];
+    double norms[dim];
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            b[i * dim + j] = m[j * dim + i];
+            u[i * dim + j] = i == j;
+        }
+    }
+    int k = 1;
+    for (long step = 0; k < dim && step < LLL_MAX_STEPS * dim * dim; step++) {
+        for (int i = 0; i <= k; i++) {
+            for (int l = 0; l < dim; l++) {
+                bs[i * dim + l] = b[i * dim + l];
+            }
+            for (int j = 0; j < i; j++) {
+                mu[i * dim + j] = dot(dim, b + i * dim, bs + j * dim) / norms[j];
+                for (int l = 0; l < dim; l++) {
+                    bs[i * dim + l] -= mu[i * dim + j] * bs[j * dim + l];
+                }
+            }
+            norms[i] = dot(dim, bs + i * dim, bs + i * dim);
+        }
+        // size reduction of b[k]
+        for (int j = k - 1; j >= 0; j--) {
+            double q = nearbyint(mu[k * dim + j]);
+            if (q != 0) {
+                for (int l = 0; l < dim; l++) {
+                    b[k * dim + l] -= q * b[j * dim + l];
+                    u[l * dim + k] -= q * u[l * dim + j];
+                }
+                for (int i = 0; i < j; i++) {
+                    mu[k * dim + i] -= q * mu[j * dim + i];
+                }
+                mu[k * dim + j] -= q;
+            }
+        }
+        // Lovasz condition, norms[k] does not change in the size reduction
+        double muk = mu[k * dim + k - 1];
+        if (norms[k] >= (LLL_DELTA - muk * muk) * norms[k - 1]) {
+            k++;
+        } else {
+            for (int l = 0; l < dim; l++) {
+                double tmp = b[k * dim + l];
+                b[k * dim + l] = b[(k - 1) * dim + l];
+                b[(k - 1) * dim + l] = tmp;
+                tmp = u[l * dim + k];
+                u[l * dim + k] = u[l * dim + k - 1];
+                u[l * dim + k - 1] = tmp;
+            }
+            k = k > 1 ? k - 1 : 1;
+        }
+    }
+}
+
+/**
+ * @brief computes the Cholesky factor of the Gram matrix of a lattice.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[out] r: upper triangular matrix with m^T m = r^T r.
+ */
+void latticeCholesky(unsigned int dim, const double *m, double *r) {
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            double g = 0;
+            for (int k = 0; k < dim; k++) {
+                g += m[k * dim + i] * m[k * dim + j];
+            }
+            for (int k = 0; k < i; k++) {
+                g -= r[k * dim + i] * r[k * dim + j];
+            }
+            if (j < i) {
+                r[i * dim + j] = 0;
+            } else if (j == i) {
+                r[i * dim + i] = sqrt(g);
+            } else {
+                r[i * dim + j] = g / r[i * dim + i];
+            }
+        }
+    }
+}
+
+/**
+ * @brief computes the center of the shifted lattice points in counting vector
+ * coordinates.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] r: Cholesky factor of the Gram matrix m^T m.
+ * @param[in] shift: shift of the lattice points.
+ * @param[out] u: center -m^{-1} shift, solved from r^T r u = -m^T shift.
+ */
+void latticeCenter(unsigned int dim, const double *m, const double *r,
+                   const double *shift, double *u) {
+    for (int i = 0; i < dim; i++) {
+        double b = 0;
+        for (int k = 0; k < dim; k++) {
+            b -= m[k * dim + i] * shift[k];
+        }
+        for (int k = 0; k < i; k++) {
+            b -= r[k * dim + i] * u[k];
+        }
+        u[i] = b / r[i * dim + i];
+    }
+    for (int i = dim - 1; i >= 0; i--) {
+        for (int k = i + 1; k < dim; k++) {
+            u[i] -= r[i * dim + k] * u[k];
+        }
+        u[i] /= r[i * dim + i];
+    }
+}
+
+/**
+ * @brief estimates the number of lattice points within a ball from the
+ * Gram-Schmidt lengths of a reduced basis, which unlike the volume of the ball
+ * also holds if the radius is below the length of the longest basis vectors.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix whose columns are a reduced basis of the lattice.
+ * @param[in] radius: radius of the ball around the origin.
+ * @return prod_k (1 + 2 * radius / r[k][k]) with the Cholesky factor r.
+ */
+double latticeCountEstimate(unsigned int dim, const double *m, double radius) {
+    double r[dim * dim];
+    latticeCholesky(dim, m, r);
+    double count = 1;
+    for (int k = 0; k < dim; k++) {
+        count *= 1 + 2 * radius / r[k * dim + k];
+    }
+    return count;
+}
+
+/**
+ * @brief appends a row to the rows of an enumeration, growing the arrays if
+ * needed.
+ * @param[in, out] rows: rows to append to.
+ * @param[in, out] capacity: number of rows that fit into the arrays.
+ * @param[in] zv: counting vector of the row, zv[0] is ignored.
+ * @param[in] lo: first zv[0] of the row.
+ * @param[in] hi: last zv[0] of the row.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int latticeRowsAppend(struct latticeRows *rows, long *capacity, const int *zv,
+                      int lo, int hi) {
+    unsigned int dim = rows->dim;
+    if (rows->nRows == *capacity) {
+        long newCapacity = 2 * *capacity;
+        int *starts = realloc(rows->starts, newCapacity * dim * sizeof(int));
+        if (starts == NULL) {
+            return 1;
+        }
+        rows->starts = starts;
+        long *firsts = realloc(rows->firsts, (newCapacity + 1) * sizeof(long));
+        if (firsts == NULL) {
+            return 1;
+        }
+        rows->firsts = firsts;
+        *capacity = newCapacity;
+    }
+    int *start = rows->starts + rows->nRows * dim;
+    bool zeroRow = true;
+    for (int k = 1; k < dim; k++) {
+        start[k] = zv[k];
+        zeroRow = zeroRow && zv[k] == 0;
+        rows->lower[k] = zv[k] < rows->lower[k] ? zv[k] : rows->lower[k];
+        rows->upper[k] = zv[k] > rows->upper[k] ? zv[k] : rows->upper[k];
+    }
+    start[0] = lo;
+    rows->lower[0] = lo < rows->lower[0] ? lo : rows->lower[0];
+    rows->upper[0] = hi > rows->upper[0] ? hi : rows->upper[0];
+    if (zeroRow && lo <= 0 && 0 <= hi) {
+        rows->zeroIndex = rows->nPoints - lo;
+    }
+    rows->nPoints += hi - lo + 1;
+    rows->nRows++;
+    rows->firsts[rows->nRows] = rows->nPoints;
+    return 0;
+}
+
+/**
+ * @brief enumerates all lattice points within an ellipsoid with the algorithm of
+ * Fincke and Pohst on the Cholesky factor of the Gram matrix.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] radius: all zv with |m zv + shift| <= radius are enumerated.
+ * @return rows of lattice points, NULL if memory allocation fails. Has to be
+ * freed with latticeRowsFree.
+ */
+struct latticeRows *latticeRowsCreate(unsigned int dim, const double *m,
+                                      const double *shift, double radius) {
+    struct latticeRows *rows =
+        malloc(sizeof(struct latticeRows) + 2 * dim * sizeof(int));
+    if (rows == NULL) {
+        return NULL;
+    }
+    long capacity = 16;
+    rows->dim = dim;
+    rows->nRows = 0;
+    rows->nPoints = 0;
+    rows->zeroIndex = -1;
+    rows->lower = (int *)(rows + 1);
+    rows->upper = rows->lower + dim;
+    rows->starts = malloc(capacity * dim * sizeof(int));
+    rows->firsts = malloc((capacity + 1) * sizeof(long));
+    if (rows->starts == NULL || rows->firsts == NULL) {
+        latticeRowsFree(rows);
+        return NULL;
+    }
+    rows->firsts[0] = 0;
+    for (int k = 0; k < dim; k++) {
+        rows->lower[k] = INT_MAX;
+        rows->upper[k] = INT_MIN;
+    }
+    // Cholesky factor r of the Gram matrix m^T m = r^T r, such that
+    // |m (zv - u)|^2 = sum_k q[k] (zv[k] - c[k])^2 with the centers
+    // c[k] = u[k] - sum_{j > k} r[k][j] / r[k][k] (zv[j] - u[j])
+    double r[dim * dim];
+    latticeCholesky(dim, m, r);
+    double u[dim];
+    latticeCenter(dim, m, r, shift, u);
+    // depth first search from the last direction to the first, every node on
+    // the lowest level is a row
+    int zv[dim];
+    int lo[dim];
+    int hi[dim];
+    double c[dim];
+    double partial[dim + 1]; // squared norm of the directions k, ..., dim - 1
+    partial[dim] = 0;
+    int k = dim - 1;
+    bool descend = true;
+    while (k < (int)dim) {
+        if (descend) {
+            c[k] = u[k];
+            for (int j = k + 1; j < dim; j++) {
+                c[k] -= r[k * dim + j] / r[k * dim + k] * (zv[j] - u[j]);
+            }
+            double rest = radius * radius - partial[k + 1];
+            double half = rest < 0 ? -1 : sqrt(rest) / r[k * dim + k];
+            lo[k] = (int)ceil(c[k] - half);
+            hi[k] = (int)floor(c[k] + half);
+            if (k == 0) {
+                if (lo[0] <= hi[0] &&
+                    latticeRowsAppend(rows, &capacity, zv, lo[0], hi[0])) {
+                    latticeRowsFree(rows);
+                    return NULL;
+                }
+                k++;
+                descend = false;
+                continue;
+            }
+            zv[k] = lo[k] - 1;
+        }
+        zv[k]++;
+        if (zv[k] > hi[k]) {
+            k++;
+            descend = false;
+            continue;
+        }
+        double diff = (zv[k] - c[k]) * r[k * dim + k];
+        partial[k] = partial[k + 1] + diff * diff;
+        k--;
+        descend = true;
+    }
+    if (rows->nPoints == 0) {
+        for (int j = 0; j < dim; j++) {
+            rows->lower[j] = rows->upper[j] = 0;
+        }
+    }
+    return rows;
+}
+
+/**
+ * @brief checks whether the shifted lattice points m zv + shift are symmetric
+ * under inversion, which holds if twice the shift is a lattice vector. The
+ * points m zv + shift and -(m zv + shift) then belong to the counting vectors zv
+ * and center2 - zv.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[out] center2: twice the center -m^{-1} shift, if it is a counting
+ * vector.
+ * @return true if the points are symmetric under inversion.
+ */
+bool latticeSymmetric(unsigned int dim, const double *m, const double *shift,
+                      int *center2) {
+    double r[dim * dim];
+    latticeCholesky(dim, m, r);
+    double u[dim];
+    latticeCenter(dim, m, r, shift, u);
+    for (int k = 0; k < dim; k++) {
+        double c = nearbyint(2 * u[k]);
+        if (fabs(2 * u[k] - c) > LATTICE_SYMMETRY_TOL * (1 + fabs(c))) {
+            return false;
+        }
+        center2[k] = (int)c;
+    }
+    return true;
+}
+
+/**
+ * @brief removes one point of every pair zv, center2 - zv from rows that are
+ * symmetric under inversion. The point with 2 zv - center2 > 0 is kept, where
+ * the last direction is compared first, such that whole rows are either kept
+ * or removed, except for the rows through the center.
+ * @param[in, out] rows: rows to halve.
+ * @param[in] center2: twice the center of the rows, from latticeSymmetric.
+ * @return flat index of the point zv = center2 / 2 that is its own partner, -1
+ * if it is not enumerated.
+ */
+long latticeRowsHalve(struct latticeRows *rows, const int *center2) {
+    unsigned int dim = rows->dim;
+    int first = (int)ceil(center2[0] / 2.);
+    long selfIndex = -1;
+    long nRows = 0;
+    long nPoints = 0;
+    rows->zeroIndex = -1;
+    for (long row = 0; row < rows->nRows; row++) {
+        const int *start = rows->starts + row * dim;
+        int lo = start[0];
+        int hi = lo + (int)(rows->firsts[row + 1] - rows->firsts[row]) - 1;
+        int sign = 0;
+        bool zeroRow = true;
+        for (int k = dim - 1; k > 0; k--) {
+            if (sign == 0) {
+                sign = 2 * start[k] - center2[k];
+            }
+            zeroRow = zeroRow && start[k] == 0;
+        }
+        if (sign < 0) {
+            continue;
+        }
+        if (sign == 0) {
+            lo = lo > first ? lo : first;
+            if (lo > hi) {
+                continue;
+            }
+            if (2 * lo == center2[0]) {
+                selfIndex = nPoints;
+            }
+        }
+        int *kept = rows->starts + nRows * dim;
+        memmove(kept, start, dim * sizeof(int));
+        kept[0] = lo;
+        if (zeroRow && lo <= 0 && 0 <= hi) {
+            rows->zeroIndex = nPoints - lo;
+        }
+        rows->firsts[nRows] = nPoints;
+        nPoints += hi - lo + 1;
+        nRows++;
+    }
+    rows->nRows = nRows;
+    rows->nPoints = nPoints;
+    rows->firsts[nRows] = nPoints;
+    return selfIndex;
+}
+
+/**
+ * @brief frees rows created by latticeRowsCreate.
+ * @param[in, out] rows: rows to free, may be NULL.
+ */
+void latticeRowsFree(struct latticeRows *rows) {
+    if (rows != NULL) {
+        free(rows->starts);
+        free(rows->firsts);
+    }
+    free(rows);
+}
+
+/**
+ * @brief moves the walker to the first point of its row, or to the lower corner
+ * of the rows after the last row, and resynchronizes it.
+ * @param[in, out] walker: walker to move.
+ */
+void latticeWalkerRowStart(struct latticeWalker *walker) {
+    const struct latticeRows *rows = walker->rows;
+    if (walker->row < rows->nRows) {
+        memcpy(walker->zv, rows->starts + walker->row * walker->dim,
+               walker->dim * sizeof(int));
+    } else {
+        memcpy(walker->zv, rows->lower, walker->dim * sizeof(int));
+    }
+    latticeWalkerResync(walker);
+}
+
+/**
+ * @brief creates a walker positioned at a flat index of the rows.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] rows: points to walk through, enumerated for the same m and shift.
+ * @param[in] r2Exact: squared norm below which the points are recomputed exactly,
+ * since the incremental update only has a small absolute error.
+ * @param[in] n: flat index to start at.
+ * @return walker, NULL if memory allocation fails. Has to be freed with
+ * latticeWalkerFree.
+ */
+struct latticeWalker *latticeWalkerCreate(unsigned int dim, const double *m,
+                                          const double *shift,
+                                          const struct latticeRows *rows,
+                                          double r2Exact, long n) {
+    struct latticeWalker *walker =
+        malloc(sizeof(struct latticeWalker) + dim * (dim + 2) * sizeof(double) +
+               dim * sizeof(int));
+    if (walker == NULL) {
+        return NULL;
+    }
+    walker->dim = dim;
+    walker->m = m;
+    walker->shift = shift;
+    walker->rows = rows;
+    walker->r2Exact = r2Exact;
+    walker->n = n;
+    walker->v = (double *)(walker + 1);
+    walker->mv = walker->v + dim;
+    walker->gram = walker->mv + dim;
+    walker->zv = (int *)(walker->gram + dim * dim);
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            double g = 0;
+            for (int k = 0; k < dim; k++) {
+                g += m[k * dim + i] * m[k * dim + j];
+            }
+            walker->gram[i * dim + j] = g;
+        }
+    }
+    // binary search for the row of the flat index
+    long first = 0;
+    long last = rows->nRows;
+    while (first < last) {
+        long mid = (first + last) / 2;
+        if (rows->firsts[mid + 1] <= n) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    walker->row = first;
+    latticeWalkerRowStart(walker);
+    if (walker->row < rows->nRows) {
+        walker->zv[0] += n - rows->firsts[walker->row];
+        latticeWalkerResync(walker);
+    }
+    return walker;
+}
+
+/**
+ * @brief frees a walker created by latticeWalkerCreate.
+ * @param[in, out] walker: walker to free, may be NULL.
+ */
+void latticeWalkerFree(struct latticeWalker *walker) { free(walker); }
+
+/**
+ * @brief recomputes the current point, its squared norm and m^T v exactly.
+ * @param[in, out] walker: walker to resynchronize.
+ */
+void latticeWalkerResync(struct latticeWalker *walker) {
+    unsigned int dim = walker->dim;
+    const double *m = walker->m;
+    matrix_intVector(dim, m, walker->zv, walker->v);
+    for (int i = 0; i < dim; i++) {
+        walker->v[i] = walker->v[i] + walker->shift[i];
+    }
+    walker->r2 = dot(dim, walker->v, walker->v);
+    for (int k = 0; k < dim; k++) {
+        walker->mv[k] = 0;
+        for (int i = 0; i < dim; i++) {
+            walker->mv[k] += m[i * dim + k] * walker->v[i];
+        }
+    }
+}
+
+/**
+ * @brief moves the walker to the next flat index. After the last point, the
+ * counting vector is set to the lower corner of the rows.
+ * @param[in, out] walker: walker to move.
+ * @return true if the walker moved to another row, i.e. zv[k] changed for
+ * some k > 0.
+ */
+bool latticeWalkerNext(struct latticeWalker *walker) {
+    unsigned int dim = walker->dim;
+    walker->n++;
+    if (walker->row < walker->rows->nRows &&
+        walker->n < walker->rows->firsts[walker->row + 1]) {
+        // |v + m e_0|^2 = |v|^2 + 2 (m^T v)_0 + (m^T m)_00
+        walker->r2 += 2 * walker->mv[0] + walker->gram[0];
+        for (int k = 0; k < dim; k++) {
+            walker->mv[k] += walker->gram[k * dim];
+        }
+        walker->zv[0]++;
+        if (walker->r2 < walker->r2Exact) {
+            latticeWalkerResync(walker);
+        }
+        return false;
+    }
+    if (walker->row < walker->rows->nRows) {
+        walker->row++;
+    }
+    latticeWalkerRowStart(walker);
+    return true;
+}
+
+#undef LLL_DELTA
+#undef LLL_MAX_STEPS
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file lattice.h
+ * @brief Enumeration of the lattice points in the sums of Crandall's formula.
+ */
+
+#ifndef LATTICE_H
+#define LATTICE_H
+#include <stdbool.h>
+
+/*!
+ * @brief argument pi |v|^2 / lambda^2 of G below which the squared norms of the
+ * walker should be recomputed exactly, as G is sensitive to relative errors of
+ * small arguments.
+ */
+#define LATTICE_EXACT_ARG 8.
+
+/*!
+ * @brief relative tolerance for twice the center of shifted lattice points to
+ * be considered a counting vector, such that the points are symmetric under
+ * inversion.
+ */
+#define LATTICE_SYMMETRY_TOL 0x1p-48
+
+/**
+ * @brief lattice points zv with |m zv + shift| <= radius, stored as rows of
+ * consecutive zv[0] for fixed zv[1], ..., zv[dim - 1]. The points are numbered
+ * row by row with a flat index.
+ */
+struct latticeRows {
+    unsigned int dim; //!< dimension of the lattice.
+    long nRows;       //!< number of rows.
+    long nPoints;     //!< number of points in all rows.
+    long zeroIndex;   //!< flat index of zv = 0, -1 if it is not enumerated.
+    int *starts;      //!< counting vectors of the first point of each row.
+    long *firsts;     //!< flat index of the first point of each row and nPoints.
+    int *lower;       //!< smallest zv[k] of all points in each direction.
+    int *upper;       //!< largest zv[k] of all points in each direction.
+};
+
+/**
+ * @brief walks through the points v = m zv + shift of a struct latticeRows in
+ * the order of the flat index. Steps within a row update |v|^2 with the Gram
+ * matrix in O(dim), the first point of every row and every point with
+ * |v|^2 < r2Exact is computed exactly.
+ */
+struct latticeWalker {
+    unsigned int dim;               //!< dimension of the lattice.
+    const double *m;                //!< matrix that transforms the lattice.
+    const double *shift;            //!< shift of the lattice points.
+    const struct latticeRows *rows; //!< points that are walked through.
+    long n;                         //!< flat index of the current point.
+    long row;                       //!< row of the current point.
+    int *zv;                        //!< counting vector of the current point.
+    double *v;                      //!< current point after the last resync.
+    double r2;                      //!< squared norm of the current point.
+    double *mv;                     //!< m^T v for the current point.
+    double *gram;                   //!< Gram matrix m^T m.
+    double r2Exact;                 //!< squared norm for exact recomputation.
+};
+
+/**
+ * @brief reduces the basis of a lattice with the algorithm of Lenstra, Lenstra
+ * and Lovasz, such that skewed bases of the same lattice lead to similar
+ * enumerations.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix whose columns are the basis vectors.
+ * @param[out] u: unimodular integer matrix, such that the columns of m u are an
+ * LLL-reduced basis of the same lattice. The identity if m is already reduced.
+ */
+void latticeReduce(unsigned int dim, const double *m, double *u);
+
+/**
+ * @brief computes the Cholesky factor of the Gram matrix of a lattice.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[out] r: upper triangular matrix with m^T m = r^T r.
+ */
+void latticeCholesky(unsigned int dim, const double *m, double *r);
+
+/**
+ * @brief estimates the number of lattice points within a ball from the
+ * Gram-Schmidt lengths of a reduced basis.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix whose columns are a reduced basis of the lattice.
+ * @param[in] radius: radius of the ball around the origin.
+ * @return prod_k (1 + 2 * radius / r[k][k]) with the Cholesky factor r.
+ */
+double latticeCountEstimate(unsigned int dim, const double *m, double radius);
+
+/**
+ * @brief enumerates all lattice points within an ellipsoid with the algorithm of
+ * Fincke and Pohst on the Cholesky factor of the Gram matrix.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] radius: all zv with |m zv + shift| <= radius are enumerated.
+ * @return rows of lattice points, NULL if memory allocation fails. Has to be
+ * freed with latticeRowsFree.
+ */
+struct latticeRows *latticeRowsCreate(unsigned int dim, const double *m,
+                                      const double *shift, double radius);
+
+/**
+ * @brief checks whether the shifted lattice points m zv + shift are symmetric
+ * under inversion, which holds if twice the shift is a lattice vector.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[out] center2: twice the center -m^{-1} shift, if it is a counting
+ * vector.
+ * @return true if the points are symmetric under inversion.
+ */
+bool latticeSymmetric(unsigned int dim, const double *m, const double *shift,
+                      int *center2);
+
+/**
+ * @brief removes one point of every pair zv, center2 - zv from rows that are
+ * symmetric under inversion.
+ * @param[in, out] rows: rows to halve.
+ * @param[in] center2: twice the center of the rows, from latticeSymmetric.
+ * @return flat index of the point zv = center2 / 2 that is its own partner, -1
+ * if it is not enumerated.
+ */
+long latticeRowsHalve(struct latticeRows *rows, const int *center2);
+
+/**
+ * @brief frees rows created by latticeRowsCreate.
+ * @param[in, out] rows: rows to free, may be NULL.
+ */
+void latticeRowsFree(struct latticeRows *rows);
+
+/**
+ * @brief creates a walker positioned at a flat index of the rows.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] rows: points to walk through, enumerated for the same m and shift.
+ * @param[in] r2Exact: squared norm below which the points are recomputed exactly,
+ * since the incremental update only has a small absolute error.
+ * @param[in] n: flat index to start at.
+ * @return walker, NULL if memory allocation fails. Has to be freed with
+ * latticeWalkerFree.
+ */
+struct latticeWalker *latticeWalkerCreate(unsigned int dim, const double *m,
+                                          const double *shift,
+                                          const struct latticeRows *rows,
+                                          double r2Exact, long n);
+
+/**
+ * @brief frees a walker created by latticeWalkerCreate.
+ * @param[in, out] walker: walker to free, may be NULL.
+ */
+void latticeWalkerFree(struct latticeWalker *walker);
+
+/**
+ * @brief moves the walker to the next flat index. After the last point, the
+ * counting vector is set to the lower corner of the rows.
+ * @param[in, out] walker: walker to move.
+ * @return true if the walker moved to another row, i.e. zv[k] changed for
+ * some k > 0.
+ */
+bool latticeWalkerNext(struct latticeWalker *walker);
+
+/**
+ * @brief recomputes the current point, its squared norm and m^T v exactly.
+ * @param[in, out] walker: walker to resynchronize.
+ */
+void latticeWalkerResync(struct latticeWalker *walker);
+#endif
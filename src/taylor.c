@@ -0,0 +1,942 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file taylor.c
+ * @brief Calculates Taylor coefficients of the (regularized) Epstein zeta
+ * function with respect to the exponent nu. In Crandall's formula, nu only
+ * enters the prefactor, the scaling and the exponents of G, so every summand is
+ * replaced by its truncated power series in nu and both lattices are traversed
+ * once for all coefficients.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "crandall.h"
+#include "lattice.h"
+#include "taylor.h"
+#include "tools.h"
+#include "zeta.h"
+
+/*!
+ * @brief smallest argument of G for which its coefficients are calculated from
+ * the continued fraction of the upper incomplete gamma function, if also
+ * t >= a / 2 - 1. Below, the series cancel in the higher coefficients.
+ */
+#define TAYLOR_CF_MIN 0.25
+
+/*!
+ * @brief maximal depth of the continued fraction.
+ */
+#define TAYLOR_CF_MAX 5000
+
+/*!
+ * @brief distance of the exponent a of G to a non-positive integer -m below
+ * which the series of G is expanded around -m.
+ */
+#define TAYLOR_NEAR 0.25
+
+/*!
+ * @brief bound on |(a + m) log(t)| for the expansion around -m, beyond it the
+ * two poles of the series do not cancel.
+ */
+#define TAYLOR_LOG_MAX 8.
+
+/*!
+ * @brief number of coefficients beyond the requested ones in the expansion
+ * around -m, sufficient for |(a + m) log(t)| <= TAYLOR_LOG_MAX.
+ */
+#define TAYLOR_EXTRA 64
+
+/*!
+ * @brief lower bound on the shifted argument of the Euler-Maclaurin formula
+ * for the Hurwitz zeta function, raised by the order.
+ */
+#define TAYLOR_EM_MIN 20
+
+/*!
+ * @brief distance of nu to dim below which the Epstein zeta function without
+ * regularization is at its pole for y on the reciprocal lattice, as in
+ * specialCase.
+ */
+#define TAYLOR_POLE_EPS ldexp(1, -30)
+
+/**
+ * @brief calculates the Taylor coefficients of -1 / (a + d) in d.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: expansion point.
+ * @param[out] out: coefficients -(-1)^k / a^(k + 1).
+ */
+void taylor_pole(unsigned int n, double a, double *out) {
+    double p = -1 / a;
+    for (int k = 0; k < n; k++) {
+        out[k] = p;
+        p /= -a;
+    }
+}
+
+/**
+ * @brief multiplies two truncated power series.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: coefficients of the first factor.
+ * @param[in] b: coefficients of the second factor.
+ * @param[out] out: coefficients of the product, may alias a or b.
+ */
+void taylor_mul(unsigned int n, const double *a, const double *b, double *out) {
+    double res[n];
+    for (int k = 0; k < n; k++) {
+        res[k] = 0;
+        for (int j = 0; j <= k; j++) {
+            res[k] += a[j] * b[k - j];
+        }
+    }
+    for (int k = 0; k < n; k++) {
+        out[k] = res[k];
+    }
+}
+
+/**
+ * @brief divides two truncated power series.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: coefficients of the dividend.
+ * @param[in] b: coefficients of the divisor, b[0] != 0.
+ * @param[out] out: coefficients of the quotient, may alias a but not b.
+ */
+void taylor_div(unsigned int n, const double *a, const double *b, double *out) {
+    for (int k = 0; k < n; k++) {
+        double r = a[k];
+        for (int j = 1; j <= k; j++) {
+            r -= b[j] * out[k - j];
+        }
+        out[k] = r / b[0];
+    }
+}
+
+/**
+ * @brief calculates the exponential of a truncated power series.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: coefficients of the exponent.
+ * @param[out] out: coefficients of exp(a), must not alias a.
+ */
+void taylor_exp(unsigned int n, const double *a, double *out) {
+    out[0] = exp(a[0]);
+    for (int k = 1; k < n; k++) {
+        out[k] = 0;
+        for (int j = 1; j <= k; j++) {
+            out[k] += j * a[j] * out[k - j];
+        }
+        out[k] /= k;
+    }
+}
+
+/**
+ * @brief calculates the coefficients of exp(c * d) in d.
+ * @param[in] n: number of coefficients.
+ * @param[in] scale: value exp(c) at d = 1 of the constant coefficient.
+ * @param[in] c: factor of d in the exponent.
+ * @param[out] out: coefficients scale * c^k / k!.
+ */
+void taylor_expLinear(unsigned int n, double scale, double c, double *out) {
+    for (int k = 0; k < n; k++) {
+        out[k] = scale;
+        scale *= c / (k + 1);
+    }
+}
+
+/**
+ * @brief returns the Bernoulli numbers for the Euler-Maclaurin formula.
+ * @return B_{2 j} for j = 1, ..., 12.
+ */
+const double *taylor_bernoulli(void) {
+    static const double bernoulli[12] = {
+        1. / 6,         -1. / 30,      1. / 42,        -1. / 30,
+        5. / 66,        -691. / 2730,  7. / 6,         -3617. / 510,
+        43867. / 798,   -174611. / 330, 854513. / 138, -236364091. / 2730};
+    return bernoulli;
+}
+
+/**
+ * @brief calculates the Hurwitz zeta function with the Euler-Maclaurin formula.
+ * @param[in] s: integer exponent, s >= 2.
+ * @param[in] x: shift, x > 0.
+ * @return sum_{j >= 0} (x + j)^(-s).
+ */
+double taylor_hurwitz(unsigned int s, double x) {
+    const double *bernoulli = taylor_bernoulli();
+    double res = 0;
+    while (x < TAYLOR_EM_MIN + s) {
+        res += pow(x, -(double)s);
+        x++;
+    }
+    double xs = pow(x, -(double)s);
+    res += x * xs / (s - 1) + xs / 2;
+    // B_{2 j} / (2 j)! * s (s + 1) ... (s + 2 j - 2) * x^(-s - 2 j + 1)
+    double factor = s * xs / (2 * x);
+    for (int j = 1; j <= 12; j++) {
+        res += bernoulli[j - 1] * factor;
+        factor *= (s + 2 * j - 1) * (s + 2 * j) / ((2 * j + 1) * (2 * j + 2.)) /
+                  (x * x);
+    }
+    return res;
+}
+
+/**
+ * @brief calculates the digamma function with the asymptotic expansion after
+ * shifting the argument.
+ * @param[in] x: argument, x > 0.
+ * @return psi(x) = gamma'(x) / gamma(x).
+ */
+double taylor_digamma(double x) {
+    const double *bernoulli = taylor_bernoulli();
+    double res = 0;
+    while (x < TAYLOR_EM_MIN) {
+        res -= 1 / x;
+        x++;
+    }
+    res += log(x) - 1 / (2 * x);
+    double x2j = 1;
+    for (int j = 1; j <= 12; j++) {
+        x2j *= x * x;
+        res -= bernoulli[j - 1] / (2 * j * x2j);
+    }
+    return res;
+}
+
+/**
+ * @brief calculates the Taylor coefficients of log(gamma(x + d)) in d.
+ * @param[in] n: number of coefficients.
+ * @param[in] x: expansion point, x > 0.
+ * @param[out] out: coefficients log(gamma(x)), psi(x) and
+ * (-1)^k zeta(k, x) / k for k >= 2.
+ */
+void taylor_lgamma(unsigned int n, double x, double *out) {
+    if (n > 0) {
+        out[0] = lgamma(x);
+    }
+    if (n > 1) {
+        out[1] = taylor_digamma(x);
+    }
+    for (int k = 2; k < n; k++) {
+        out[k] = (k % 2 ? -1 : 1) * taylor_hurwitz(k, x) / k;
+    }
+}
+
+/**
+ * @brief calculates the Taylor coefficients of sin(pi * (a + d)) in d.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: expansion point.
+ * @param[out] out: coefficients, exactly zero for k = 0 at integer a.
+ */
+void taylor_sinpi(unsigned int n, double a, double *out) {
+    double r = nearbyint(a);
+    double sign = fmod(r, 2) == 0 ? 1 : -1;
+    double sp = sign * sin(M_PI * (a - r));
+    double cp = sign * cos(M_PI * (a - r));
+    double values[4] = {sp, cp, -sp, -cp};
+    double factor = 1;
+    for (int k = 0; k < n; k++) {
+        out[k] = values[k % 4] * factor;
+        factor *= M_PI / (k + 1);
+    }
+}
+
+/**
+ * @brief calculates the Taylor coefficients of gamma(1 - a - d) in d, for the
+ * reflection formula.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: expansion point, a < 1.
+ * @param[out] out: coefficients.
+ */
+void taylor_gammaReflected(unsigned int n, double a, double *out) {
+    double lg[n];
+    taylor_lgamma(n, 1 - a, lg);
+    for (int k = 1; k < n; k += 2) {
+        lg[k] = -lg[k];
+    }
+    taylor_exp(n, lg, out);
+}
+
+/**
+ * @brief calculates the Taylor coefficients of gamma(a + d) in d.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: expansion point, not a non-positive integer.
+ * @param[out] out: coefficients.
+ */
+void taylor_gamma(unsigned int n, double a, double *out) {
+    if (a >= 0.5) {
+        double lg[n];
+        taylor_lgamma(n, a, lg);
+        taylor_exp(n, lg, out);
+    } else {
+        // gamma(a) = pi / (sin(pi a) gamma(1 - a))
+        double s[n];
+        double pi[n];
+        taylor_sinpi(n, a, s);
+        taylor_gammaReflected(n, a, out);
+        taylor_mul(n, s, out, s);
+        for (int k = 0; k < n; k++) {
+            pi[k] = k == 0 ? M_PI : 0;
+        }
+        taylor_div(n, pi, s, out);
+    }
+}
+
+/**
+ * @brief calculates the Taylor coefficients of 1 / gamma(a + d) in d.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: expansion point.
+ * @param[out] out: coefficients.
+ */
+void taylor_rgamma(unsigned int n, double a, double *out) {
+    if (a >= 0.5) {
+        double lg[n];
+        taylor_lgamma(n, a, lg);
+        for (int k = 0; k < n; k++) {
+            lg[k] = -lg[k];
+        }
+        taylor_exp(n, lg, out);
+    } else {
+        // 1 / gamma(a) = sin(pi a) gamma(1 - a) / pi
+        double s[n];
+        taylor_sinpi(n, a, s);
+        taylor_gammaReflected(n, a, out);
+        taylor_mul(n, s, out, out);
+        for (int k = 0; k < n; k++) {
+            out[k] /= M_PI;
+        }
+    }
+}
+
+/**
+ * @brief constants of the Taylor coefficients of G_{2 (a + d)} in d that do not
+ * depend on the argument, computed once by taylor_gInit.
+ */
+struct taylorG {
+    unsigned int n; //!< number of coefficients.
+    double a;       //!< half the exponent of G at the expansion point.
+    int m;          //!< -m is the non-positive integer near a, -1 if there is none.
+    double *gamma;  //!< coefficients of gamma(a + d), NULL at the poles.
+    double *q;      //!< coefficients of gamma(1 + h) / prod_{j < m} (j - m + h).
+};
+
+/**
+ * @brief precomputes the coefficients of G_{2 (a + d)} that do not depend on
+ * the argument.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: half the exponent of G at the expansion point.
+ * @param[out] ctx: constants, have to be freed with taylor_gFree.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int taylor_gInit(unsigned int n, double a, struct taylorG *ctx) {
+    ctx->n = n;
+    ctx->a = a;
+    ctx->m = -1;
+    ctx->gamma = NULL;
+    ctx->q = NULL;
+    double r = nearbyint(a);
+    if (r <= 0 && fabs(a - r) < TAYLOR_NEAR) {
+        // Q(h) = gamma(1 + h) / prod_{j < m} (j - m + h)
+        unsigned int nq = n + TAYLOR_EXTRA;
+        ctx->m = (int)-r;
+        ctx->q = malloc(nq * sizeof(double));
+        if (ctx->q == NULL) {
+            return 1;
+        }
+        double lg[nq];
+        taylor_lgamma(nq, 1, lg);
+        taylor_exp(nq, lg, ctx->q);
+        for (int j = 0; j < ctx->m; j++) {
+            for (int k = 0; k < nq; k++) {
+                ctx->q[k] = (ctx->q[k] - (k > 0 ? ctx->q[k - 1] : 0)) /
+                            (j - ctx->m);
+            }
+        }
+    }
+    if (a != r || r > 0) {
+        ctx->gamma = malloc(n * sizeof(double));
+        if (ctx->gamma == NULL) {
+            free(ctx->q);
+            ctx->q = NULL;
+            return 1;
+        }
+        taylor_gamma(n, a, ctx->gamma);
+    }
+    return 0;
+}
+
+/**
+ * @brief frees the constants of taylor_gInit.
+ * @param[in] ctx: constants.
+ */
+void taylor_gFree(struct taylorG *ctx) {
+    free(ctx->gamma);
+    free(ctx->q);
+}
+
+/**
+ * @brief subtracts the Taylor coefficients of the series
+ * sum_{j >= 0} (-t)^j / (j! (a + j + d)) in d.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: half the exponent at the expansion point.
+ * @param[in] t: argument, t < 1.
+ * @param[in] skip: index of a summand to leave out, -1 for none.
+ * @param[in, out] out: coefficients.
+ */
+void taylor_subSeries(unsigned int n, double a, double t, int skip,
+                      double *out) {
+    double c = 1;
+    for (int j = 0; j < TAYLOR_CF_MAX; j++) {
+        if (j != skip) {
+            double p = 1 / (a + j);
+            double term = c * p;
+            for (int k = 0; k < n; k++) {
+                out[k] -= term;
+                term *= -p;
+            }
+        }
+        c *= -t / (j + 1);
+        if (fabs(c) < ldexp(1, -64) && j + a > 1) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief calculates the Taylor coefficients of the continued fraction
+ * f = b_0 - a_1 / (b_1 - a_2 / (b_2 - ...)) with a_j = j (j - a - d) and
+ * b_j = t + 2 j + 1 - a - d, such that gamma(a + d, t) = exp(-t) t^(a + d) / f.
+ * The depth is that of the modified Lentz method for the value and the first
+ * coefficient, since for positive integers a the fraction terminates for d = 0
+ * but not for its coefficients. The coefficients are then evaluated backwards,
+ * with one division of power series per step.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: half the exponent at the expansion point.
+ * @param[in] t: argument, t >= a / 2 - 1.
+ * @param[out] out: coefficients of exp(-t) / f.
+ */
+void taylor_gCF(unsigned int n, double a, double t, double *out) {
+    double tiny = 1e-300;
+    // value and first coefficient of the modified Lentz method
+    double b = t + 1 - a;
+    double c0 = 1 / tiny;
+    double c1 = 0;
+    double d0 = fabs(b) < tiny ? 1 / tiny : 1 / b;
+    double d1 = d0 * d0;
+    int depth = 1;
+    for (; depth < TAYLOR_CF_MAX; depth++) {
+        double an = -depth * (depth - a);
+        b += 2;
+        double e0 = an * d0 + b;
+        double e1 = an * d1 + depth * d0 - 1;
+        e0 = fabs(e0) < tiny ? tiny : e0;
+        c1 = -1 + (depth * c0 - an * c1) / (c0 * c0);
+        c0 = b + an / c0;
+        c0 = fabs(c0) < tiny ? tiny : c0;
+        d0 = 1 / e0;
+        d1 = -e1 * d0 * d0;
+        if (fabs(d0 * c0 - 1) < ldexp(1, -54) &&
+            fabs(d0 * c1 + d1 * c0) < ldexp(1, -54)) {
+            break;
+        }
+    }
+    // the coefficients of higher order converge slightly slower
+    depth += depth / 4 + 8;
+    double f[n];
+    double num[n];
+    for (int k = 0; k < n; k++) {
+        f[k] = k == 0 ? t + 2 * depth + 1 - a : k == 1 ? -1 : 0;
+        num[k] = 0;
+    }
+    for (int j = depth; j >= 1; j--) {
+        num[0] = j * (j - a);
+        if (n > 1) {
+            num[1] = -j;
+        }
+        taylor_div(n, num, f, out);
+        for (int k = 0; k < n; k++) {
+            f[k] = (k == 0 ? t + 2 * j - 1 - a : k == 1 ? -1 : 0) - out[k];
+        }
+    }
+    for (int k = 0; k < n; k++) {
+        num[k] = k == 0 ? exp(-t) : 0;
+    }
+    taylor_div(n, num, f, out);
+}
+
+/**
+ * @brief calculates the Taylor coefficients of the series of the lower
+ * incomplete gamma function
+ * gamma_l(a + d, t) t^(-a - d) = exp(-t) sum_j t^j / prod_{i <= j} (a + d + i).
+ * @param[in] n: number of coefficients.
+ * @param[in] a: half the exponent at the expansion point, a > 0.
+ * @param[in] t: argument.
+ * @param[out] out: coefficients.
+ */
+void taylor_gLower(unsigned int n, double a, double t, double *out) {
+    double term[n];
+    taylor_pole(n, a, term);
+    for (int k = 0; k < n; k++) {
+        term[k] = -term[k];
+        out[k] = term[k];
+    }
+    for (int j = 1; j < TAYLOR_CF_MAX; j++) {
+        // the summands decrease once a + j > t
+        double p = 1 / (a + j);
+        for (int k = 0; k < n; k++) {
+            term[k] = (t * term[k] - (k > 0 ? term[k - 1] : 0)) * p;
+            out[k] += term[k];
+        }
+        if (a + j > t && term[0] < ldexp(1, -60) * out[0]) {
+            break;
+        }
+    }
+    for (int k = 0; k < n; k++) {
+        out[k] *= exp(-t);
+    }
+}
+
+/**
+ * @brief calculates the Taylor coefficients of the series
+ * G_{2 (a + d)}(t) = gamma(a + d) t^(-a - d) - sum_j (-t)^j / (j! (a + d + j))
+ * near a non-positive integer -m, where both terms have a pole. With
+ * h = a + d + m, the poles cancel in (P(h) - P(0)) / h with
+ * P(h) = Q(h) t^(m - h). Its coefficients in h are re-expanded around a + m.
+ * @param[in] ctx: constants from taylor_gInit, with m >= 0.
+ * @param[in] t: argument, 0 < t < TAYLOR_CF_MIN.
+ * @param[out] out: coefficients.
+ */
+void taylor_gNear(const struct taylorG *ctx, double t, double *out) {
+    unsigned int n = ctx->n;
+    unsigned int nq = n + TAYLOR_EXTRA;
+    double eta = ctx->a + ctx->m;
+    double p[nq];
+    taylor_expLinear(nq, pow(t, ctx->m), -log(t), p);
+    taylor_mul(nq, ctx->q, p, p);
+    // Taylor shift of sum_{j >= 1} p_j h^(j - 1) to h = eta + d
+    double *r = p + 1;
+    unsigned int deg = nq - 2;
+    for (int k = 0; k < n; k++) {
+        for (int l = deg - 1; l >= k; l--) {
+            r[l] += eta * r[l + 1];
+        }
+        out[k] = r[k];
+    }
+    taylor_subSeries(n, ctx->a, t, ctx->m, out);
+}
+
+/**
+ * @brief calculates the Taylor coefficients of gamma(a + d) t^(-a - d) in d.
+ * @param[in] ctx: constants from taylor_gInit, a not a non-positive integer.
+ * @param[in] t: argument, t > 0.
+ * @param[out] out: ctx->n coefficients.
+ */
+void taylor_gammaPower(const struct taylorG *ctx, double t, double *out) {
+    taylor_expLinear(ctx->n, pow(t, -ctx->a), -log(t), out);
+    taylor_mul(ctx->n, ctx->gamma, out, out);
+}
+
+/**
+ * @brief calculates the Taylor coefficients of G_{2 (a + d)}(t) in d, with
+ * G_nu(t) = gamma(nu / 2, t) t^(-nu / 2) and G_nu(0) = -2 / nu.
+ * @param[in] ctx: constants from taylor_gInit.
+ * @param[in] t: argument.
+ * @param[out] out: ctx->n coefficients.
+ */
+void taylor_g(const struct taylorG *ctx, double t, double *out) {
+    unsigned int n = ctx->n;
+    double a = ctx->a;
+    if (t < ldexp(1, -62)) {
+        taylor_pole(n, a, out);
+    } else if (ctx->m >= 0 && t < TAYLOR_CF_MIN &&
+               fabs((a + ctx->m) * log(t)) <= TAYLOR_LOG_MAX) {
+        taylor_gNear(ctx, t, out);
+    } else if (t >= fmax(a / 2 - 1, TAYLOR_CF_MIN)) {
+        taylor_gCF(n, a, t, out);
+    } else if (a > 0) {
+        double lower[n];
+        taylor_gLower(n, a, t, lower);
+        taylor_gammaPower(ctx, t, out);
+        for (int k = 0; k < n; k++) {
+            out[k] -= lower[k];
+        }
+    } else {
+        taylor_gammaPower(ctx, t, out);
+        taylor_subSeries(n, a, t, -1, out);
+    }
+}
+
+/**
+ * @brief calculates the Taylor coefficients of
+ * G_{2 (a + d)}(t) - gamma(a + d) t^(-a - d) in d, the summand for k = 0 of the
+ * regularized second sum in Crandall's formula.
+ * @param[in] ctx: constants from taylor_gInit, a not a non-positive integer if
+ * t > 0.
+ * @param[in] t: argument.
+ * @param[out] out: ctx->n coefficients.
+ */
+void taylor_gReg(const struct taylorG *ctx, double t, double *out) {
+    unsigned int n = ctx->n;
+    double a = ctx->a;
+    if (t < ldexp(1, -62)) {
+        taylor_pole(n, a, out);
+    } else if (a > 0 && t < a + 1) {
+        // -gamma_l(a + d, t) t^(-a - d) without cancellation
+        taylor_gLower(n, a, t, out);
+        for (int k = 0; k < n; k++) {
+            out[k] = -out[k];
+        }
+    } else if (a <= 0 && t < 1) {
+        for (int k = 0; k < n; k++) {
+            out[k] = 0;
+        }
+        taylor_subSeries(n, a, t, -1, out);
+    } else {
+        double p[n];
+        taylor_gCF(n, a, t, out);
+        taylor_gammaPower(ctx, t, p);
+        for (int k = 0; k < n; k++) {
+            out[k] -= p[k];
+        }
+    }
+}
+
+/**
+ * @brief sums the Taylor coefficients of G in nu, weighted with the phases, for
+ * one of the sums in Crandall's formula in one traversal.
+ * @param[in] g: constants of G from taylor_gInit.
+ * @param[in] scale: change of the variable of g per unit of nu, 1 / 2 for the
+ * first sum and -1 / 2 for the second.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase.
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] rows: points v = m zv + shift within the cutoff radius, enumerated
+ * with latticeRowsCreate for the shift.
+ * @param[in] skipZero: true to skip the summand for zv = 0.
+ * @param[out] zeroArg: true if a summand with vanishing argument was left out,
+ * its coefficients depend on the prefactor of the sum.
+ * @param[out] sums: g->n coefficients of
+ * sum_{zv} G_nu(argScale |v|^2) exp(-2 * PI * I * (m zv) * w) in nu.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int taylor_sums(const struct taylorG *g, double scale, unsigned int dim,
+                const double *m, const double *shift, const double *w,
+                double argScale, const struct latticeRows *rows, bool skipZero,
+                bool *zeroArg, double complex *sums) {
+    unsigned int n = g->n;
+    double complex epsilons[n];
+    double scales[n];
+    double coeffs[n];
+    for (int k = 0; k < n; k++) {
+        sums[k] = 0;
+        epsilons[k] = 0;
+        scales[k] = k == 0 ? 1 : scales[k - 1] * scale;
+    }
+    *zeroArg = false;
+    double complex phases[phaseTableSize(rows)];
+    long offsets[dim];
+    phaseTable(dim, m, w, rows, phases, offsets);
+    struct latticeWalker *walker = latticeWalkerCreate(
+        dim, m, shift, rows, LATTICE_EXACT_ARG / argScale, 0);
+    if (walker == NULL) {
+        return 1;
+    }
+    double complex rotOuter = phaseOuter(dim, walker->zv, rows, phases, offsets);
+    for (long j = 0; j < rows->nPoints; j++) {
+        double t = walker->r2 * argScale;
+        if (skipZero && j == rows->zeroIndex) {
+            // the summand is added by the caller
+        } else if (t < ldexp(1, -62)) {
+            *zeroArg = true;
+        } else {
+            double complex rot =
+                rotOuter * phases[walker->zv[0] - rows->lower[0]];
+            taylor_g(g, t, coeffs);
+            for (int k = 0; k < n; k++) {
+                // summing using Kahan's method
+                double complex auxy = rot * coeffs[k] * scales[k] - epsilons[k];
+                double complex auxt = sums[k] + auxy;
+                epsilons[k] = (auxt - sums[k]) - auxy;
+                sums[k] = auxt;
+            }
+        }
+        if (latticeWalkerNext(walker)) {
+            rotOuter = phaseOuter(dim, walker->zv, rows, phases, offsets);
+        }
+    }
+    latticeWalkerFree(walker);
+    return 0;
+}
+
+/**
+ * @brief adds the Taylor coefficients in nu of the summand of one point w of
+ * the second sum in Crandall's formula.
+ * @param[in] g: constants of G_{dim - nu} from taylor_gInit.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] w: shifted point of the reciprocal lattice.
+ * @param[in] x: vector in the phase exp(-2 * PI * I * x * w).
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] sign: 1 to add the summand, -1 to remove it.
+ * @param[in, out] sums: g->n coefficients of the second sum.
+ */
+void taylor_addFourier(const struct taylorG *g, unsigned int dim,
+                       const double *w, const double *x, double argScale,
+                       double sign, double complex *sums) {
+    unsigned int n = g->n;
+    double coeffs[n];
+    taylor_g(g, argScale * dot(dim, w, w), coeffs);
+    double complex e = sign * cexp(-2 * M_PI * I * dot(dim, x, w));
+    for (int k = 0; k < n; k++) {
+        sums[k] += e * coeffs[k];
+        e *= -0.5;
+    }
+}
+
+/**
+ * @brief multiplies a truncated power series with real coefficients and one with
+ * complex coefficients.
+ * @param[in] n: number of coefficients.
+ * @param[in] a: real coefficients of the first factor.
+ * @param[in] b: complex coefficients of the second factor.
+ * @param[out] out: coefficients of the product, may alias b.
+ */
+void taylor_mulComplex(unsigned int n, const double *a, const double complex *b,
+                       double complex *out) {
+    for (int k = n - 1; k >= 0; k--) {
+        double complex res = 0;
+        for (int j = 0; j <= k; j++) {
+            res += a[j] * b[k - j];
+        }
+        out[k] = res;
+    }
+}
+
+/**
+ * @brief assembles the Taylor coefficients of the (regularized) Epstein zeta
+ * function in nu for the lattice of unit volume from those of the sums in
+ * Crandall's formula and of its prefactor
+ * (lambda^2 / PI)^(-nu / 2) / gamma(nu / 2).
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x_t1: scaled x vector.
+ * @param[in] y_t1: scaled y vector.
+ * @param[in] x_t2: x_t1 projected to the elementary lattice cell.
+ * @param[in] y_t2: y_t1 projected to the elementary reciprocal lattice cell.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[in] n: number of coefficients.
+ * @param[out] out: n coefficients, NAN at the poles in nu.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int taylor_crandall(const struct epsteinZetaPlan *plan, const double *x_t1,
+                    const double *y_t1, const double *x_t2, const double *y_t2,
+                    int reg, unsigned int n, double complex *out) {
+    double nu = plan->nu;
+    unsigned int dim = plan->dim;
+    double lambda = plan->lambda;
+    double argReal = M_PI / (lambda * lambda);
+    double argFourier = M_PI * lambda * lambda;
+    double a = nu / 2;
+    double b = (dim - nu) / 2.;
+    // poles of the summand for k = 0 of the second sum and, with the
+    // regularization, of gamma(b) at non-positive integers b
+    if ((reg == 0 && fabs(nu - dim) < TAYLOR_POLE_EPS &&
+         equalsZero(dim, y_t2)) ||
+        (reg && b <= 0 && b == nearbyint(b) &&
+         (b == 0 || !equalsZero(dim, y_t1)))) {
+        for (int k = 0; k < n; k++) {
+            out[k] = NAN;
+        }
+        return 0;
+    }
+    double shift[dim];
+    for (int i = 0; i < dim; i++) {
+        shift[i] = -x_t2[i];
+    }
+    const double *xf = reg ? x_t1 : x_t2;
+    struct taylorG gReal;
+    struct taylorG gFourier;
+    if (taylor_gInit(n, a, &gReal) != 0) {
+        return 1;
+    }
+    if (taylor_gInit(n, b, &gFourier) != 0) {
+        taylor_gFree(&gReal);
+        return 1;
+    }
+    double complex s1[n];
+    double complex s2[n];
+    bool zeroReal;
+    bool zeroFourier;
+    struct latticeRows *rowsReal =
+        latticeRowsCreate(dim, plan->m_real, shift, plan->radiusReal);
+    struct latticeRows *rowsFourier =
+        latticeRowsCreate(dim, plan->m_fourier, y_t2, plan->radiusFourier);
+    bool failed =
+        rowsReal == NULL || rowsFourier == NULL ||
+        taylor_sums(&gReal, 0.5, dim, plan->m_real, shift, y_t2, argReal,
+                    rowsReal, false, &zeroReal, s1) != 0 ||
+        taylor_sums(&gFourier, -0.5, dim, plan->m_fourier, y_t2, xf,
+                    argFourier, rowsFourier, true, &zeroFourier, s2) != 0;
+    latticeRowsFree(rowsReal);
+    latticeRowsFree(rowsFourier);
+    if (failed) {
+        taylor_gFree(&gReal);
+        taylor_gFree(&gFourier);
+        return 1;
+    }
+    // phases exp(-2 * PI * I * xf * (k + y_t2)) of the second sum
+    double complex rotY = cexp(-2 * M_PI * I * dot(dim, y_t2, xf));
+    for (int k = 0; k < n; k++) {
+        s2[k] *= rotY;
+    }
+    // prefactor in d = (nu' - nu) / 2, with one more coefficient for the
+    // regularized summand -1 / (a + d) of the first sum, which cancels the zero
+    // of 1 / gamma(a + d) at a = 0
+    double c[n + 1];
+    double power[n + 1];
+    taylor_rgamma(n + 1, a, c);
+    taylor_expLinear(n + 1, pow(lambda * lambda / M_PI, -a),
+                     -log(lambda * lambda / M_PI), power);
+    taylor_mul(n + 1, c, power, c);
+    double complex zero[n];
+    for (int k = 0; k < n; k++) {
+        zero[k] = 0;
+    }
+    if (zeroReal) {
+        double q = 0;
+        for (int k = 0; k < n; k++) {
+            q = a == 0 ? c[k + 1] : (c[k] - q) / a;
+            zero[k] = -q;
+        }
+    }
+    for (int k = 0; k < n; k++) {
+        c[k] = ldexp(c[k], -k);
+        zero[k] = ldexp(1, -k) * zero[k];
+    }
+    double vx[dim];
+    for (int i = 0; i < dim; i++) {
+        vx[i] = x_t1[i] - x_t2[i];
+    }
+    double complex xfactor = cexp(-2 * M_PI * I * dot(dim, vx, y_t1));
+    double lambdaDim = pow(lambda, dim);
+    if (reg) {
+        // the second sum without k = 0 is k + y_t1 != y_t1, where y_t1 may
+        // differ from y_t2
+        if (!equals(dim, y_t1, y_t2)) {
+            taylor_addFourier(&gFourier, dim, y_t2, x_t1, argFourier, 1, s2);
+            taylor_addFourier(&gFourier, dim, y_t1, x_t1, argFourier, -1, s2);
+        }
+        double complex rot = cexp(2 * M_PI * I * dot(dim, x_t1, y_t1));
+        double gReg[n];
+        taylor_gReg(&gFourier, argFourier * dot(dim, y_t1, y_t1), gReg);
+        taylor_mulComplex(n, c, s1, s1);
+        for (int k = 0; k < n; k++) {
+            s2[k] = rot * s2[k] + ldexp(gReg[k], -k) * (k % 2 ? -1 : 1);
+        }
+        taylor_mulComplex(n, c, s2, s2);
+        // the regularized summand and the second sum do not have the phase
+        // xfactor of the shifted x
+        for (int k = 0; k < n; k++) {
+            out[k] = xfactor * rot * (s1[k] + zero[k]) + lambdaDim * s2[k];
+        }
+    } else {
+        taylor_addFourier(&gFourier, dim, y_t2, x_t2, argFourier, 1, s2);
+        for (int k = 0; k < n; k++) {
+            s1[k] += lambdaDim * s2[k];
+        }
+        taylor_mulComplex(n, c, s1, s1);
+        for (int k = 0; k < n; k++) {
+            out[k] = xfactor * (s1[k] + zero[k]);
+        }
+    }
+    taylor_gFree(&gReal);
+    taylor_gFree(&gFourier);
+    return 0;
+}
+
+/**
+ * @brief calculates the Taylor coefficients of the (regularized) Epstein zeta
+ * function in nu from the scaled and projected vectors.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x_t1: scaled x vector.
+ * @param[in] y_t1: scaled y vector.
+ * @param[in] x_t2: x_t1 projected to the elementary lattice cell.
+ * @param[in] y_t2: y_t1 projected to the elementary reciprocal lattice cell.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[in] n: number of coefficients.
+ * @param[out] out: n coefficients, NAN at the poles in nu.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int taylor_execute(const struct epsteinZetaPlan *plan, const double *x_t1,
+                   const double *y_t1, const double *x_t2, const double *y_t2,
+                   int reg, unsigned int n, double complex *out) {
+    double nu = plan->nu;
+    double ms = plan->ms;
+    if (taylor_crandall(plan, x_t1, y_t1, x_t2, y_t2, reg, n, out) != 0) {
+        for (int k = 0; k < n; k++) {
+            out[k] = NAN;
+        }
+        return 1;
+    }
+    // scaling to the lattice of volume ms^(-dim) with ms^nu
+    double scale[n];
+    taylor_expLinear(n, pow(ms, nu), log(ms), scale);
+    taylor_mulComplex(n, scale, out, out);
+    return 0;
+}
+
+/**
+ * @brief calculates the first Taylor coefficients of the (regularized) Epstein
+ * zeta function in nu, with all coefficients from one traversal of each
+ * lattice.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[in] n: number of coefficients.
+ * @param[out] out: n coefficients (d / d nu)^k Z / k!, NAN at the poles in nu.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaTaylorNuInternal(double nu, unsigned int dim, const double *m,
+                                const double *x, const double *y, int reg,
+                                unsigned int n, double complex *out) {
+    if (n == 0) {
+        return 0;
+    }
+    struct epsteinZetaPlan *plan = epsteinZetaPlanInternal(nu, dim, m, 0, 0);
+    if (plan == NULL) {
+        for (int k = 0; k < n; k++) {
+            out[k] = NAN;
+        }
+        return 1;
+    }
+    double ms = plan->ms;
+    double x_t1[dim];
+    double y_t1[dim];
+    for (int i = 0; i < dim; i++) {
+        x_t1[i] = x[i] * ms;
+        y_t1[i] = y[i] / ms;
+    }
+    double *x_t2 = vectorProj(dim, plan->m_real, plan->m_realInvt, x_t1);
+    double *y_t2 = vectorProj(dim, plan->m_realInvt, plan->m_real, y_t1);
+    int res = taylor_execute(plan, x_t1, y_t1, x_t2, y_t2, reg, n, out);
+    free(x_t2);
+    free(y_t2);
+    epsteinZetaPlanFree(plan);
+    return res;
+}
+#undef TAYLOR_CF_MIN
+#undef TAYLOR_CF_MAX
+#undef TAYLOR_NEAR
+#undef TAYLOR_LOG_MAX
+#undef TAYLOR_EXTRA
+#undef TAYLOR_EM_MIN
+#undef TAYLOR_POLE_EPS
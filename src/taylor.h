@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file taylor.h
+ * @brief Calculates Taylor coefficients of the (regularized) Epstein zeta
+ * function with respect to the exponent nu.
+ */
+
+#ifndef TAYLOR_H
+#define TAYLOR_H
+#include <complex.h>
+
+/**
+ * @brief calculates the first Taylor coefficients of the (regularized) Epstein
+ * zeta function in nu, with all coefficients from one traversal of each
+ * lattice.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[in] n: number of coefficients.
+ * @param[out] out: n coefficients (d / d nu)^k Z / k!, NAN at the poles in nu.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int epsteinZetaTaylorNuInternal(double nu, unsigned int dim, const double *m,
+                                const double *x, const double *y, int reg,
+                                unsigned int n, double complex *out);
+#endif
@@ -3,6 +3,11 @@
 // SPDX-License-Identifier: AGPL-3.0-only
 
 #include "../crandall.h"
+#include "../gamma.h"
+#include "../lattice.h"
+#ifdef EPSTEIN_QUAD
+#include "../gammaq.h"
+#endif
 #include "utils.h"
 #include <complex.h>
 #include <errno.h>
@@ -109,7 +114,292 @@ int test_crandall_g(void) {
     return (testsPassed == totalTests) ? 0 : 1;
 }
 
+/*!
+ * @brief Test function for crandall_gBlock against crandall_gArg.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_crandall_gBlock(void) {
+    double nus[5] = {-3.5, 0.5, 2, 3.7, 9};
+    double zArguments[100];
+    double g[100];
+    double tol = pow(10, -15);
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int i = 0; i < 100; i++) {
+        zArguments[i] = 0.08 * i * i;
+    }
+    zArguments[99] = 2000;
+    printf("Block evaluation of G ... ");
+    for (int k = 0; k < 5; k++) {
+        double zArgBound = assignzArgBound(nus[k]);
+        struct egfContext gamma;
+        egf_contextInit(nus[k] / 2, &gamma);
+        crandall_gBlock(nus[k], 100, zArguments, zArgBound, &gamma, NULL, g);
+        for (int i = 0; i < 100; i++) {
+            double ref = crandall_gArg(nus[k], zArguments[i], zArgBound);
+            double errorAbs = errAbs(ref, g[i]);
+            double errorRel = errRel(ref, g[i]);
+            double errorMaxAbsRel = (errorAbs < errorRel) ? errorAbs : errorRel;
+            totalTests++;
+            if (errorMaxAbsRel < tol) {
+                testsPassed++;
+            } else {
+                printf("\nWarning! crandall_gBlock(%lf, %lf): %.16e != %.16e\n",
+                       nus[k], zArguments[i], g[i], ref);
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for crandall_gBlock with a table of G against
+ * crandall_gArg.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_crandall_gTable(void) {
+    double nus[6] = {-30, -3.5, 0, 2, 3.7, 25};
+    double zArguments[100];
+    double g[100];
+    double tol = pow(10, -13);
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int i = 0; i < 100; i++) {
+        zArguments[i] = 0.0037 * (i + 1) * (i + 1);
+    }
+    printf("Tables of G ... ");
+    for (int k = 0; k < 6; k++) {
+        double zArgBound = assignzArgBound(nus[k]);
+        struct crandallGTable *table = crandall_gTableCreate(nus[k], zArgBound);
+        totalTests++;
+        if (table == NULL) {
+            printf("\nWarning! no table for nu = %lf\n", nus[k]);
+            continue;
+        }
+        testsPassed++;
+        struct egfContext gamma;
+        egf_contextInit(nus[k] / 2, &gamma);
+        crandall_gBlock(nus[k], 100, zArguments, zArgBound, &gamma, table, g);
+        for (int i = 0; i < 100; i++) {
+            double ref = crandall_gArg(nus[k], zArguments[i], zArgBound);
+            totalTests++;
+            if (errRel(ref, g[i]) < tol) {
+                testsPassed++;
+            } else {
+                printf("\nWarning! crandall_gBlock(%lf, %lf): %.16e != %.16e\n",
+                       nus[k], zArguments[i], g[i], ref);
+            }
+        }
+        free(table);
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the closed forms of G against the upper incomplete
+ * gamma function.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_crandall_gClosedBlock(void) {
+    double nus[6] = {1, 2, 3, 4, 9, 20};
+    double zArguments[100];
+    double es[100];
+    double g[100];
+    double tol = pow(10, -13);
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int i = 0; i < 100; i++) {
+        zArguments[i] = 0.004 * (i + 1) * (i + 1);
+        es[i] = exp(-zArguments[i]);
+    }
+    printf("Closed forms of G ... ");
+    for (int k = 0; k < 6; k++) {
+        totalTests++;
+        if (crandall_gHasClosedForm(nus[k])) {
+            testsPassed++;
+        } else {
+            printf("\nWarning! no closed form for nu = %lf\n", nus[k]);
+        }
+        crandall_gClosedBlock(nus[k], 100, zArguments, es, g);
+        for (int i = 0; i < 100; i++) {
+            double ref = egf_ugamma(nus[k] / 2, zArguments[i]) /
+                         pow(zArguments[i], nus[k] / 2);
+            totalTests++;
+            if (errRel(ref, g[i]) < tol) {
+                testsPassed++;
+            } else {
+                printf("\nWarning! crandall_gClosedBlock(%lf, %lf): %.16e != "
+                       "%.16e\n",
+                       nus[k], zArguments[i], g[i], ref);
+            }
+        }
+    }
+    double noClosedForm[4] = {0, -2, 2.5, 34};
+    for (int k = 0; k < 4; k++) {
+        totalTests++;
+        if (!crandall_gHasClosedForm(noClosedForm[k])) {
+            testsPassed++;
+        } else {
+            printf("\nWarning! closed form for nu = %lf\n", noClosedForm[k]);
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for egf_ugamma_batch against egf_ugamma.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_egf_ugamma_batch(void) {
+    double as[8] = {-4.75, -1.5, -0.25, 0.3, 1.5, 5.25, 14, 31.5};
+    double xs[300];
+    double out[300];
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int i = 0; i < 300; i++) {
+        xs[i] = 0.0005 * i * i + 0.001;
+    }
+    printf("Batched upper incomplete gamma ... ");
+    for (int k = 0; k < 8; k++) {
+        egf_ugamma_batch(as[k], xs, 300, out);
+        for (int i = 0; i < 300; i++) {
+            double ref = egf_ugamma(as[k], xs[i]);
+            totalTests++;
+            if (ref == out[i] || (isnan(ref) && isnan(out[i]))) {
+                testsPassed++;
+            } else {
+                printf("\nWarning! egf_ugamma_batch(%lf, %lf): %.16e != %.16e\n",
+                       as[k], xs[i], out[i], ref);
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for latticeRowsCreate and latticeWalkerNext against a brute
+ * force count of the lattice points in the ball.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_latticeRows(void) {
+    double m[9] = {1.1, 0.7, -0.3, 0, 0.8, 0.45, 0, 0, 1.3};
+    double shift[3] = {0.2, -0.35, 0.1};
+    double radius = 3.7;
+    int testsPassed = 0;
+    int totalTests = 0;
+    printf("Ellipsoid enumeration of lattice points ... ");
+    struct latticeRows *rows = latticeRowsCreate(3, m, shift, radius);
+    struct latticeWalker *walker = latticeWalkerCreate(3, m, shift, rows, 0, 0);
+    // every enumerated point lies in the ball and its incremental squared norm
+    // agrees with the direct one
+    for (long n = 0; n < rows->nPoints; n++, latticeWalkerNext(walker)) {
+        double v[3];
+        double r2 = 0;
+        for (int i = 0; i < 3; i++) {
+            v[i] = shift[i];
+            for (int j = 0; j < 3; j++) {
+                v[i] += m[i * 3 + j] * walker->zv[j];
+            }
+            r2 += v[i] * v[i];
+        }
+        totalTests++;
+        if (r2 <= radius * radius && fabs(r2 - walker->r2) < 1e-12) {
+            testsPassed++;
+        } else {
+            printf("\nWarning! point %ld: |v|^2 = %.16e, walker %.16e\n", n, r2,
+                   walker->r2);
+        }
+    }
+    // no point in the ball is missed
+    long count = 0;
+    for (int z0 = -20; z0 <= 20; z0++) {
+        for (int z1 = -20; z1 <= 20; z1++) {
+            for (int z2 = -20; z2 <= 20; z2++) {
+                int zv[3] = {z0, z1, z2};
+                double r2 = 0;
+                for (int i = 0; i < 3; i++) {
+                    double v = shift[i];
+                    for (int j = 0; j < 3; j++) {
+                        v += m[i * 3 + j] * zv[j];
+                    }
+                    r2 += v * v;
+                }
+                count += r2 <= radius * radius;
+            }
+        }
+    }
+    totalTests++;
+    if (count == rows->nPoints) {
+        testsPassed++;
+    } else {
+        printf("\nWarning! %ld points enumerated, %ld in the ball\n",
+               rows->nPoints, count);
+    }
+    latticeWalkerFree(walker);
+    latticeRowsFree(rows);
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the incomplete gamma functions in quadruple
+ * precision, one reference value for each domain of the algorithm.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_egf_ugammaq(void) {
+    printf("Incomplete gamma functions in quadruple precision ... ");
+#ifdef EPSTEIN_QUAD
+    __float128 as[10] = {-3.25Q, 1e-12Q, 0, 2.5Q, 0.5Q, 12, -7, -2.5Q, 3, 1.5Q};
+    __float128 xs[10] = {0.3Q, 1, 1.5Q, 1, 10, 5, 3, 0.7Q, 0.1Q, 20};
+    __float128 refs[10] = {10.1407910566685751275720888428603373Q,
+                           0.219383934395618116874380481242939115Q,
+                           0.100019582406632651901909339911666978Q,
+                           1.12880279188910228636323388371173155Q,
+                           0.0000137262662354498576604977377126366738Q,
+                           39699130.0207267880046984535218553028Q,
+                           0.0000022079474994431912439779899163454088Q,
+                           0.562265157655442827722238681076208142Q,
+                           0.15465307026467165350478931168753358Q,
+                           0.0111803397683714170130605640613082429Q};
+    int testsPassed = 0;
+    int totalTests = 10;
+    for (int i = 0; i < totalTests; i++) {
+        // the last three reference values are of the twice regularized lower
+        // incomplete gamma function
+        __float128 val =
+            i < 7 ? egf_ugammaq(as[i], xs[i]) : egf_gammaStarq(as[i], xs[i]);
+        if (fabsq(val - refs[i]) <= 1e-31Q * fabsq(refs[i])) {
+            testsPassed++;
+        } else {
+            printf("\nWarning! a = %lf, x = %lf: %.20e != %.20e\n", (double)as[i],
+                   (double)xs[i], (double)val, (double)refs[i]);
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+#else
+    printf("skipped, built without __float128.\n");
+    return 0;
+#endif
+}
+
 int main(void) {
     int result = test_crandall_g();
+    result |= test_crandall_gBlock();
+    result |= test_crandall_gTable();
+    result |= test_crandall_gClosedBlock();
+    result |= test_egf_ugamma_batch();
+    result |= test_latticeRows();
+    result |= test_egf_ugammaq();
     return result;
 }
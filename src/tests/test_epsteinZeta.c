@@ -212,7 +212,1038 @@ int test_epsteinZeta_epsteinZetaReg() {
     return (testsPassedOverall == totalTestsOverall) ? 0 : 1;
 }
 
+/*!
+ * @brief Test function for evaluations with a precomputed plan.
+ *
+ * Evaluates every line of the reference files with epsteinZetaPlanExecute and
+ * epsteinZetaPlanExecuteReg, executing each plan twice to make sure that
+ * executing does not modify the plan.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaPlan() {
+    const char *files[2] = {"epsteinZeta_Ref.csv", "epsteinZetaReg_Ref.csv"};
+    int dim = 2;
+    double a[4];
+    double nu[2];
+    double x[2];
+    double y[2];
+    double zetaRef[2];
+    double tol = pow(10, -13);
+    int testsPassedOverall = 0;
+    int totalTestsOverall = 0;
+    char path[MAX_PATH_LENGTH];
+    char line[256];
+    for (int reg = 0; reg < 2; reg++) {
+        int testsPassed = 0;
+        int totalTests = 0;
+        int result = snprintf(path, sizeof(path), "%s/%s", BASE_PATH, // NOLINT
+                              files[reg]);
+        if (result < 0 || result >= sizeof(path)) {
+            return fprintf(stderr, "Error creating file path\n");
+        }
+        FILE *refData = fopen(path, "r");
+        if (refData == NULL) {
+            return fprintf(stderr, "Error opening file: %s\n", path);
+        }
+        printf("Processing file with plan: %s ... ", path);
+        while (fgets(line, sizeof(line), refData) != NULL) {
+            int scanResult = sscanf( // NOLINT
+                line, "%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf", nu,
+                nu + 1, a, a + 1, a + 2, a + 3, x, x + 1, y, y + 1, zetaRef,
+                zetaRef + 1);
+            if (scanResult != 12) {
+                printf("Error reading line: %s\n", line);
+                continue;
+            }
+            epsteinZetaPlan *plan = epsteinZetaPlanCreate(nu[0], dim, a);
+            double complex zetaM = zetaRef[0] + zetaRef[1] * I;
+            for (int rep = 0; rep < 2; rep++) {
+                double complex zetaC = reg ? epsteinZetaPlanExecuteReg(plan, x, y)
+                                           : epsteinZetaPlanExecute(plan, x, y);
+                double errorAbs = errAbs(zetaC, zetaM);
+                double errorRel = errRel(zetaC, zetaM);
+                double errorMaxAbsRel = (errorAbs < errorRel) ? errorAbs : errorRel;
+                totalTests++;
+                if (errorMaxAbsRel < tol) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! plan: %.16lf %+.16lf I != %.16lf %+.16lf I\n",
+                           creal(zetaC), cimag(zetaC), creal(zetaM), cimag(zetaM));
+                }
+            }
+            epsteinZetaPlanDestroy(plan);
+        }
+        if (fclose(refData) != 0) {
+            return fprintf(stderr, "Error closing file: %d\n", errno);
+        }
+        printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+        testsPassedOverall += testsPassed;
+        totalTestsOverall += totalTests;
+    }
+    return (testsPassedOverall == totalTestsOverall) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for batched evaluations over many x or y vectors.
+ *
+ * Compares epsteinZetaBatchY, epsteinZetaRegBatchY, epsteinZetaBatchX and
+ * epsteinZetaRegBatchX with single evaluations of epsteinZeta and
+ * epsteinZetaReg for a skewed three dimensional lattice.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaBatch() {
+    int dim = 3;
+    double a[9] = {1, 0.3, -0.2, 0, 0.9, 0.4, 0.1, 0, 1.2};
+    double v[3] = {0.3, -0.7, 1.4};
+    int n = 20;
+    double vs[60];
+    double complex out[20];
+    double nus[3] = {1, 3, 4.5};
+    double tol = pow(10, -14);
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int i = 0; i < n * dim; i++) {
+        vs[i] = sin(1.7 * i) * (i % 5);
+    }
+    vs[0] = vs[1] = vs[2] = 0;
+    printf("Batched evaluation over x and y vectors ... ");
+    for (int k = 0; k < 6; k++) {
+        double nu = nus[k % 3];
+        int batchX = k >= 3;
+        for (int reg = 0; reg < 2; reg++) {
+            int status;
+            if (batchX) {
+                status = reg ? epsteinZetaRegBatchX(nu, dim, a, vs, v, n, out)
+                             : epsteinZetaBatchX(nu, dim, a, vs, v, n, out);
+            } else {
+                status = reg ? epsteinZetaRegBatchY(nu, dim, a, v, vs, n, out)
+                             : epsteinZetaBatchY(nu, dim, a, v, vs, n, out);
+            }
+            for (int i = 0; i < n; i++) {
+                const double *x = batchX ? vs + i * dim : v;
+                const double *y = batchX ? v : vs + i * dim;
+                double complex ref = reg ? epsteinZetaReg(nu, dim, a, x, y)
+                                         : epsteinZeta(nu, dim, a, x, y);
+                double errorAbs = errAbs(ref, out[i]);
+                double errorRel = errRel(ref, out[i]);
+                totalTests++;
+                double errorMaxAbsRel = (errorAbs < errorRel) ? errorAbs : errorRel;
+                if (status == 0 && (errorMaxAbsRel < tol ||
+                                    (isnan(creal(ref)) && isnan(creal(out[i]))))) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! batch: %.16lf %+.16lf I != "
+                           "%.16lf %+.16lf I\n",
+                           creal(out[i]), cimag(out[i]), creal(ref), cimag(ref));
+                }
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for batched evaluations over many exponents.
+ *
+ * Compares epsteinZetaBatchNu and epsteinZetaRegBatchNu with single
+ * evaluations of epsteinZeta and epsteinZetaReg for a skewed three dimensional
+ * lattice, including exponents at the poles and vectors at lattice points.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaBatchNu() {
+    int dim = 3;
+    double a[9] = {1, 0.3, -0.2, 0, 0.9, 0.4, 0.1, 0, 1.2};
+    double xs[9] = {0.3, -0.7, 1.4, 0, 0, 0, 0.1, 0.2, 0.3};
+    double ys[9] = {0.5, 0.2, -0.1, 0.2, -1.1, 0.4, 0, 0, 0};
+    double nus[12] = {0.5, 1, 2.5, 3, 4.5, 5, 6.5, -1, 2, -2, 8.5, 0};
+    int n = 12;
+    double complex out[12];
+    double tol = pow(10, -13);
+    int testsPassed = 0;
+    int totalTests = 0;
+    printf("Batched evaluation over exponents ... ");
+    for (int k = 0; k < 3; k++) {
+        for (int reg = 0; reg < 2; reg++) {
+            const double *x = xs + k * dim;
+            const double *y = ys + k * dim;
+            int status = reg ? epsteinZetaRegBatchNu(nus, dim, a, x, y, n, out)
+                             : epsteinZetaBatchNu(nus, dim, a, x, y, n, out);
+            for (int i = 0; i < n; i++) {
+                double complex ref = reg ? epsteinZetaReg(nus[i], dim, a, x, y)
+                                         : epsteinZeta(nus[i], dim, a, x, y);
+                double errorAbs = errAbs(ref, out[i]);
+                double errorRel = errRel(ref, out[i]);
+                totalTests++;
+                double errorMaxAbsRel = (errorAbs < errorRel) ? errorAbs : errorRel;
+                if (status == 0 &&
+                    (errorMaxAbsRel < tol || ref == out[i] ||
+                     (isnan(creal(ref)) && isnan(creal(out[i]))))) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! batch nu = %lf: %.16lf %+.16lf I != "
+                           "%.16lf %+.16lf I\n",
+                           nus[i], creal(out[i]), cimag(out[i]), creal(ref),
+                           cimag(ref));
+                }
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the multithreaded evaluation.
+ *
+ * Compares epsteinZeta and epsteinZetaReg with two, four and eight threads with
+ * the single threaded evaluation for a four dimensional lattice, and checks
+ * that epsteinZetaGetNumThreads returns the number of threads that was set.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaThreads() {
+    int dim = 4;
+    double a[16] = {1, 0.2, 0, -0.1, 0, 1.3, 0.4, 0,
+                    0.1, 0, 0.8, 0.2, 0, 0, 0.3, 1.1};
+    double x[4] = {0.3, -0.7, 1.4, 0.2};
+    double y[4] = {0.5, 0.2, -0.1, 0.9};
+    double nus[4] = {-1.5, 1, 4, 6.5};
+    double tol = pow(10, -14);
+    int testsPassed = 0;
+    int totalTests = 0;
+    printf("Multithreaded evaluation ... ");
+    for (int k = 0; k < 4; k++) {
+        for (int reg = 0; reg < 2; reg++) {
+            epsteinZetaSetNumThreads(1);
+            double complex ref = reg ? epsteinZetaReg(nus[k], dim, a, x, y)
+                                     : epsteinZeta(nus[k], dim, a, x, y);
+            for (unsigned int threads = 2; threads <= 8; threads *= 2) {
+                epsteinZetaSetNumThreads(threads);
+                double complex val = reg ? epsteinZetaReg(nus[k], dim, a, x, y)
+                                         : epsteinZeta(nus[k], dim, a, x, y);
+                double errorAbs = errAbs(ref, val);
+                double errorRel = errRel(ref, val);
+                totalTests++;
+                double errorMaxAbsRel = (errorAbs < errorRel) ? errorAbs : errorRel;
+                if (epsteinZetaGetNumThreads() == threads && errorMaxAbsRel < tol) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! %u threads: %.16lf %+.16lf I != "
+                           "%.16lf %+.16lf I\n",
+                           threads, creal(val), cimag(val), creal(ref), cimag(ref));
+                }
+            }
+        }
+    }
+    epsteinZetaSetNumThreads(1);
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for batches of independent evaluations.
+ *
+ * Evaluates tasks with different exponents, dimensions and regularizations with
+ * epsteinZetaBatchTasks on three threads and compares their results with single
+ * evaluations of epsteinZeta and epsteinZetaReg.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaBatchTasks() {
+    double a2[4] = {1, 0, 0, 2};
+    double a3[9] = {1, 0.3, -0.2, 0, 0.9, 0.4, 0.1, 0, 1.2};
+    double a4[16] = {1, 0.2, 0, -0.1, 0, 1.3, 0.4, 0,
+                     0.1, 0, 0.8, 0.2, 0, 0, 0.3, 1.1};
+    double v[4] = {0.3, -0.7, 1.4, 0.2};
+    double w[4] = {0.5, 0.2, -0.1, 0.9};
+    const double *as[3] = {a2, a3, a4};
+    epsteinZetaTask tasks[30];
+    int n = 30;
+    double tol = pow(10, -14);
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned int dim = 2 + (i * 7) % 3;
+        tasks[i] =
+            (epsteinZetaTask){-1.5 + 0.75 * i, dim, as[dim - 2], v, w, i % 2, 0};
+    }
+    printf("Batched evaluation of independent tasks ... ");
+    epsteinZetaSetNumThreads(3);
+    int status = epsteinZetaBatchTasks(tasks, n);
+    epsteinZetaSetNumThreads(1);
+    for (int i = 0; i < n; i++) {
+        double complex ref =
+            tasks[i].reg
+                ? epsteinZetaReg(tasks[i].nu, tasks[i].dim, tasks[i].a, v, w)
+                : epsteinZeta(tasks[i].nu, tasks[i].dim, tasks[i].a, v, w);
+        double errorAbs = errAbs(ref, tasks[i].result);
+        double errorRel = errRel(ref, tasks[i].result);
+        totalTests++;
+        double errorMaxAbsRel = (errorAbs < errorRel) ? errorAbs : errorRel;
+        if (status == 0 &&
+            (errorMaxAbsRel < tol ||
+             (isnan(creal(ref)) && isnan(creal(tasks[i].result))))) {
+            testsPassed++;
+        } else {
+            printf("\nWarning! task %d: %.16lf %+.16lf I != %.16lf %+.16lf I\n", i,
+                   creal(tasks[i].result), cimag(tasks[i].result), creal(ref),
+                   cimag(ref));
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for strongly skewed bases of the lattice.
+ *
+ * Compares epsteinZeta and epsteinZetaReg for a basis that is sheared with a
+ * unimodular matrix with the evaluation for the original basis of the same
+ * lattice.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaSkewedBasis() {
+    int dim = 3;
+    double a[9] = {1.125, 0.25, 0, -0.375, 0.875, 0.125, 0.25, 0, 1.25};
+    // unimodular matrix that shears the basis strongly, b = a * u is exact
+    double u[9] = {1, 12, -9, 5, 61, -41, -3, -29, 56};
+    double b[9];
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            b[i * dim + j] = 0;
+            for (int k = 0; k < dim; k++) {
+                b[i * dim + j] += a[i * dim + k] * u[k * dim + j];
+            }
+        }
+    }
+    double x[3] = {0.3, -0.7, 1.4};
+    double y[3] = {0.5, 0.2, -0.1};
+    double nus[4] = {-1.5, 1, 4, 6.5};
+    double tol = pow(10, -12);
+    int testsPassed = 0;
+    int totalTests = 0;
+    printf("Evaluation for a skewed basis of the lattice ... ");
+    for (int k = 0; k < 4; k++) {
+        for (int reg = 0; reg < 2; reg++) {
+            double complex ref = reg ? epsteinZetaReg(nus[k], dim, a, x, y)
+                                     : epsteinZeta(nus[k], dim, a, x, y);
+            double complex val = reg ? epsteinZetaReg(nus[k], dim, b, x, y)
+                                     : epsteinZeta(nus[k], dim, b, x, y);
+            double errorAbs = errAbs(ref, val);
+            double errorRel = errRel(ref, val);
+            totalTests++;
+            double errorMaxAbsRel = (errorAbs < errorRel) ? errorAbs : errorRel;
+            if (errorMaxAbsRel < tol) {
+                testsPassed++;
+            } else {
+                printf("\nWarning! nu = %lf: %.16lf %+.16lf I != "
+                       "%.16lf %+.16lf I\n",
+                       nus[k], creal(val), cimag(val), creal(ref), cimag(ref));
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the evaluation with a given weight lambda.
+ *
+ * Compares epsteinZetaLambda and epsteinZetaRegLambda for several lambda with
+ * epsteinZeta and epsteinZetaReg, whose values do not depend on lambda, for an
+ * anisotropic lattice.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaLambda() {
+    int dim = 3;
+    double a[9] = {1, 0.1, 0, 0, 1, 0, 0, 0, 64};
+    double x[3] = {0.2, -0.4, 0.3};
+    double y[3] = {0.1, 0.3, -0.05};
+    // nu = dim + 2 covers the logarithmic term of the regularization
+    double nus[4] = {-1.5, 0.5, 3.5, 5};
+    double lambdas[3] = {0.5, 1, 2};
+    double tol = pow(10, -13);
+    int testsPassed = 0;
+    int totalTests = 0;
+    printf("Independence of the weight lambda ... ");
+    for (int k = 0; k < 4; k++) {
+        for (int reg = 0; reg < 2; reg++) {
+            double complex ref = reg ? epsteinZetaReg(nus[k], dim, a, x, y)
+                                     : epsteinZeta(nus[k], dim, a, x, y);
+            for (int l = 0; l < 3; l++) {
+                double complex val =
+                    reg ? epsteinZetaRegLambda(nus[k], dim, a, x, y, lambdas[l])
+                        : epsteinZetaLambda(nus[k], dim, a, x, y, lambdas[l]);
+                double errorAbs = errAbs(ref, val);
+                double errorRel = errRel(ref, val);
+                totalTests++;
+                double errorMaxAbsRel = (errorAbs < errorRel) ? errorAbs : errorRel;
+                if (errorMaxAbsRel < tol) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! nu = %lf, lambda = %lf: %.16lf %+.16lf I != "
+                           "%.16lf %+.16lf I\n",
+                           nus[k], lambdas[l], creal(val), cimag(val), creal(ref),
+                           cimag(ref));
+                }
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the evaluation up to a tolerance.
+ *
+ * Compares epsteinZetaTol, epsteinZetaRegTol and plans from
+ * epsteinZetaPlanCreateTol with epsteinZeta and epsteinZetaReg for a skewed
+ * lattice in one to three dimensions, up to the requested relative error.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaTol() {
+    double a[9] = {1, 0.3, 0.1, 0, 1.2, 0.2, 0, 0, 0.9};
+    double x[3] = {0.1, 0.2, 0.3};
+    double y[3] = {0.3, -0.2, 0.1};
+    // the last two exponents never use the asymptotic expansion of G in one of
+    // the sums
+    double nus[7] = {-2.5, 0.5, 2, 3.5, 7, 80.5, -79.5};
+    double tols[3] = {1e-3, 1e-6, 1e-10};
+    int testsPassed = 0;
+    int totalTests = 0;
+    printf("Evaluation up to a tolerance ... ");
+    for (int dim = 1; dim <= 3; dim++) {
+        for (int k = 0; k < 7; k++) {
+            double complex ref = epsteinZeta(nus[k], dim, a, x, y);
+            double complex refReg = epsteinZetaReg(nus[k], dim, a, x, y);
+            for (int l = 0; l < 3; l++) {
+                epsteinZetaPlan *plan =
+                    epsteinZetaPlanCreateTol(nus[k], dim, a, tols[l]);
+                double complex vals[3] = {
+                    epsteinZetaTol(nus[k], dim, a, x, y, tols[l]),
+                    epsteinZetaRegTol(nus[k], dim, a, x, y, tols[l]),
+                    epsteinZetaPlanExecute(plan, x, y)};
+                double complex refs[3] = {ref, refReg, ref};
+                epsteinZetaPlanDestroy(plan);
+                for (int i = 0; i < 3; i++) {
+                    totalTests++;
+                    if (errRel(refs[i], vals[i]) < tols[l]) {
+                        testsPassed++;
+                    } else {
+                        printf("\nWarning! dim = %d, nu = %lf, tol = %e: %.16lf "
+                               "%+.16lf I != %.16lf %+.16lf I\n",
+                               dim, nus[k], tols[l], creal(vals[i]), cimag(vals[i]),
+                               creal(refs[i]), cimag(refs[i]));
+                    }
+                }
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the lattice sums in single precision.
+ *
+ * Compares epsteinZetaf, epsteinZetaRegf, epsteinZetaPlanExecutef and
+ * epsteinZetaPlanExecuteRegf with the double precision evaluation for a skewed
+ * lattice in one to three dimensions, up to a relative error of 1e-5.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaFloat() {
+    double a[9] = {1, 0.3, 0.1, 0, 1.2, 0.2, 0, 0, 0.9};
+    double x[3] = {0.1, 0.2, 0.3};
+    double y[3] = {0.3, -0.2, 0.1};
+    float af[9];
+    float xf[3];
+    float yf[3];
+    for (int i = 0; i < 9; i++) {
+        af[i] = a[i];
+    }
+    for (int i = 0; i < 3; i++) {
+        xf[i] = x[i];
+        yf[i] = y[i];
+    }
+    double nus[5] = {-2.5, 0.5, 2, 3.5, 7};
+    // the inputs rounded to float change the reference values by up to 6e-6
+    double tol = 1e-5;
+    int testsPassed = 0;
+    int totalTests = 0;
+    printf("Single precision lattice sums ... ");
+    for (int dim = 1; dim <= 3; dim++) {
+        for (int k = 0; k < 5; k++) {
+            epsteinZetaPlan *plan = epsteinZetaPlanCreate(nus[k], dim, a);
+            double complex refs[4] = {epsteinZeta(nus[k], dim, a, x, y),
+                                      epsteinZetaReg(nus[k], dim, a, x, y)};
+            refs[2] = refs[0];
+            refs[3] = refs[1];
+            float complex vals[4] = {
+                epsteinZetaf(nus[k], dim, af, xf, yf),
+                epsteinZetaRegf(nus[k], dim, af, xf, yf),
+                epsteinZetaPlanExecutef(plan, xf, yf),
+                epsteinZetaPlanExecuteRegf(plan, xf, yf)};
+            epsteinZetaPlanDestroy(plan);
+            for (int i = 0; i < 4; i++) {
+                totalTests++;
+                if (errRel(refs[i], vals[i]) < tol) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! dim = %d, nu = %lf: %.8f %+.8f I != "
+                           "%.8lf %+.8lf I\n",
+                           dim, nus[k], crealf(vals[i]), cimagf(vals[i]),
+                           creal(refs[i]), cimag(refs[i]));
+                }
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the evaluation in quadruple precision.
+ *
+ * Compares epsteinZetaQuad and epsteinZetaPlanExecuteQuad with closed forms for
+ * the integer and the square lattice up to 1e-15, and all quadruple precision
+ * functions with the double precision evaluation for a skewed lattice.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaQuad() {
+    printf("Quadruple precision evaluation ... ");
+#ifdef EPSTEIN_QUAD
+    // 2 zeta(nu) for the integer lattice and 4 zeta(nu / 2) beta(nu / 2) for the
+    // square lattice, where the double precision evaluation is off by up to 30
+    // units in the last place close to nu = 2 and nu = 4
+    double a[4] = {1, 0, 0, 1};
+    double zero[2] = {0, 0};
+    unsigned int dims[8] = {1, 1, 1, 1, 2, 2, 2, 2};
+    double nus[8] = {2, 3, 4, 6, 3, 4, 5, 8};
+    double refs[8] = {3.2898681336964528729, 2.4041138063191885708,
+                      2.164646467422276383,  2.0346861239688982794,
+                      9.0336216831009503057, 6.0268120396919401235,
+                      5.0902582336654829457, 4.2814306608057805856};
+    double tol = 1e-15;
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int k = 0; k < 8; k++) {
+        epsteinZetaPlan *plan = epsteinZetaPlanCreate(nus[k], dims[k], a);
+        double complex vals[2] = {
+            epsteinZetaQuad(nus[k], dims[k], a, zero, zero),
+            epsteinZetaPlanExecuteQuad(plan, zero, zero)};
+        epsteinZetaPlanDestroy(plan);
+        for (int i = 0; i < 2; i++) {
+            totalTests++;
+            if (errRel(refs[k], vals[i]) < tol) {
+                testsPassed++;
+            } else {
+                printf("\nWarning! dim = %d, nu = %lf: %.16lf %+.16lf I != "
+                       "%.16lf\n",
+                       dims[k], nus[k], creal(vals[i]), cimag(vals[i]), refs[k]);
+            }
+        }
+    }
+    // agreement with double precision for general lattices and vectors
+    double b[9] = {1, 0.3, 0.1, 0, 1.2, 0.2, 0, 0, 0.9};
+    double x[3] = {0.1, 0.2, 0.3};
+    double y[3] = {0.3, -0.2, 0.1};
+    double nusGeneral[4] = {-2.5, 0.5, 3.5, 7};
+    for (int dim = 1; dim <= 3; dim++) {
+        for (int k = 0; k < 4; k++) {
+            epsteinZetaPlan *plan = epsteinZetaPlanCreate(nusGeneral[k], dim, b);
+            double complex ref = epsteinZeta(nusGeneral[k], dim, b, x, y);
+            double complex refReg = epsteinZetaReg(nusGeneral[k], dim, b, x, y);
+            double complex refsGeneral[4] = {ref, refReg, ref, refReg};
+            double complex vals[4] = {
+                epsteinZetaQuad(nusGeneral[k], dim, b, x, y),
+                epsteinZetaRegQuad(nusGeneral[k], dim, b, x, y),
+                epsteinZetaPlanExecuteQuad(plan, x, y),
+                epsteinZetaPlanExecuteRegQuad(plan, x, y)};
+            epsteinZetaPlanDestroy(plan);
+            for (int i = 0; i < 4; i++) {
+                totalTests++;
+                if (errRel(refsGeneral[i], vals[i]) < 1e-13) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! dim = %d, nu = %lf: %.16lf %+.16lf I != "
+                           "%.16lf %+.16lf I\n",
+                           dim, nusGeneral[k], creal(vals[i]), cimag(vals[i]),
+                           creal(refsGeneral[i]), cimag(refsGeneral[i]));
+                }
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+#else
+    printf("skipped, built without __float128.\n");
+    return 0;
+#endif
+}
+
+/*!
+ * @brief Test function for inversion symmetric vectors.
+ *
+ * Compares epsteinZeta for x and y at lattice and half lattice points, where only
+ * one summand of every pair v and -v is evaluated, with closed forms and the
+ * Madelung constant of NaCl.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaSymmetric() {
+    printf("Inversion symmetric vectors ... ");
+    // closed forms for x and y at half lattice points, where only half of the
+    // summands are evaluated: 14 zeta(3), -2 eta(3), -4 beta(3 / 2) eta(3 / 2),
+    // -4 beta(5 / 2) eta(5 / 2) and the Madelung constant of NaCl
+    double a1[1] = {1};
+    double a2[4] = {1, 0, 0, 1};
+    double a3[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    double zero[3] = {0, 0, 0};
+    double half[3] = {0.5, 0.5, 0.5};
+    unsigned int dims[5] = {1, 1, 2, 2, 3};
+    const double *ms[5] = {a1, a1, a2, a2, a3};
+    double nus[5] = {3, 3, 3, 5, 1};
+    const double *xs[5] = {half, zero, zero, zero, zero};
+    const double *ys[5] = {zero, half, half, half, half};
+    double refs[5] = {16.828796644234319996, -1.8030853547393914281,
+                      -2.645886532306435039, -3.2905801761577228309,
+                      -1.7475645946331821906};
+    double tol = 1e-14;
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int k = 0; k < 5; k++) {
+        totalTests++;
+        double complex val = epsteinZeta(nus[k], dims[k], ms[k], xs[k], ys[k]);
+        if (errRel(refs[k], val) < tol) {
+            testsPassed++;
+        } else {
+            printf("\nWarning! dim = %d, nu = %lf: %.16lf %+.16lf I != %.16lf\n",
+                   dims[k], nus[k], creal(val), cimag(val), refs[k]);
+        }
+    }
+    // the summands for n and 1 - n cancel for x = y = 1 / 2
+    totalTests++;
+    double complex val = epsteinZeta(2.5, 1, a1, half, half);
+    if (errAbs(0, val) < tol) {
+        testsPassed++;
+    } else {
+        printf("\nWarning! %.16lf %+.16lf I != 0\n", creal(val), cimag(val));
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for plans with tables of G.
+ *
+ * Compares epsteinZetaPlanCreateTabulated with epsteinZetaPlanCreate for a
+ * skewed lattice in one to three dimensions.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaTabulated() {
+    printf("Plans with tables of G ... ");
+    double a[9] = {1, 0.3, 0.1, 0, 1.2, 0.2, 0, 0, 0.9};
+    double x[3] = {0.1, 0.2, 0.3};
+    double y[3] = {0.3, -0.2, 0.1};
+    double nus[6] = {-3.5, 0.5, 1, 2, 3.7, 9};
+    double tol = pow(10, -13);
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int dim = 1; dim <= 3; dim++) {
+        for (int k = 0; k < 6; k++) {
+            epsteinZetaPlan *plan = epsteinZetaPlanCreate(nus[k], dim, a);
+            epsteinZetaPlan *tabulated =
+                epsteinZetaPlanCreateTabulated(nus[k], dim, a, 0);
+            double complex refs[2] = {epsteinZetaPlanExecute(plan, x, y),
+                                      epsteinZetaPlanExecuteReg(plan, x, y)};
+            double complex vals[2] = {epsteinZetaPlanExecute(tabulated, x, y),
+                                      epsteinZetaPlanExecuteReg(tabulated, x, y)};
+            epsteinZetaPlanDestroy(plan);
+            epsteinZetaPlanDestroy(tabulated);
+            for (int i = 0; i < 2; i++) {
+                totalTests++;
+                if (errRel(refs[i], vals[i]) < tol) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! dim = %d, nu = %lf: %.16lf %+.16lf I != "
+                           "%.16lf %+.16lf I\n",
+                           dim, nus[k], creal(vals[i]), cimag(vals[i]),
+                           creal(refs[i]), cimag(refs[i]));
+                }
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the one-dimensional evaluation.
+ *
+ * Compares epsteinZeta and epsteinZetaReg in one dimension, which do not use a
+ * plan, with plans for several exponents, lattice constants and vectors,
+ * including lattice points and vectors outside of the elementary cell.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZeta1d() {
+    printf("One-dimensional lattices ... ");
+    double as[3] = {1, -0.7, 2.3};
+    double xs[4] = {0, 0.1, -1.35, 2.3};
+    double ys[4] = {0, 0.3, 0.01, -1 / 0.7};
+    double nus[7] = {-3.5, -2, 0.5, 1, 2, 3.7, 9};
+    double tol = pow(10, -13);
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int k = 0; k < 7; k++) {
+        for (int l = 0; l < 3; l++) {
+            epsteinZetaPlan *plan = epsteinZetaPlanCreate(nus[k], 1, as + l);
+            for (int i = 0; i < 4; i++) {
+                double complex refs[2] = {
+                    epsteinZetaPlanExecute(plan, xs + i, ys + i),
+                    epsteinZetaPlanExecuteReg(plan, xs + i, ys + i)};
+                double complex vals[2] = {
+                    epsteinZeta(nus[k], 1, as + l, xs + i, ys + i),
+                    epsteinZetaReg(nus[k], 1, as + l, xs + i, ys + i)};
+                for (int j = 0; j < 2; j++) {
+                    totalTests++;
+                    if (refs[j] == vals[j] ||
+                        (isnan(creal(refs[j])) && isnan(creal(vals[j]))) ||
+                        errRel(refs[j], vals[j]) < tol ||
+                        errAbs(refs[j], vals[j]) < tol) {
+                        testsPassed++;
+                    } else {
+                        printf("\nWarning! nu = %lf, a = %lf, x = %lf, y = %lf: "
+                               "%.16lf %+.16lf I != %.16lf %+.16lf I\n",
+                               nus[k], as[l], xs[i], ys[i], creal(vals[j]),
+                               cimag(vals[j]), creal(refs[j]), cimag(refs[j]));
+                    }
+                }
+            }
+            epsteinZetaPlanDestroy(plan);
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for block diagonal lattices.
+ *
+ * Compares the integer lattices in four and eight dimensions with closed forms
+ * from the sums of four and eight squares, and a block diagonal lattice with
+ * the quadruple precision evaluation.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaBlockDiagonal() {
+    printf("Block diagonal lattices ... ");
+    // 8 (1 - 4^(1 - nu / 2)) zeta(nu / 2) zeta(nu / 2 - 1) in four and
+    // 16 (1 - 2^(1 - s) + 2^(4 - 2 s)) zeta(s) zeta(s - 3) with s = nu / 2 in
+    // eight dimensions
+    double a[64] = {0};
+    for (int i = 0; i < 8; i++) {
+        a[9 * i] = 1;
+    }
+    double b[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    double zero[8] = {0};
+    unsigned int dims[6] = {4, 4, 4, 8, 8, 8};
+    const double *ms[6] = {b, b, b, a, a, a};
+    double nus[6] = {3, 6, 10, 5, 10, 12};
+    double refs[6] = {-15.259976476623477636, 14.829782627229720886,
+                      8.9432564147893399580,  -5.1154763537613290598,
+                      26.011586286760727967,  19.031447399027600025};
+    double tol = pow(10, -14);
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int k = 0; k < 6; k++) {
+        totalTests++;
+        double complex val = epsteinZeta(nus[k], dims[k], ms[k], zero, zero);
+        if (errRel(refs[k], val) < tol) {
+            testsPassed++;
+        } else {
+            printf("\nWarning! dim = %d, nu = %lf: %.16lf %+.16lf I != %.16lf\n",
+                   dims[k], nus[k], creal(val), cimag(val), refs[k]);
+        }
+    }
+#ifdef EPSTEIN_QUAD
+    // a skewed block and two one-dimensional blocks
+    double c[16] = {1, 0.4, 0, 0, 0, 0.9, 0, 0, 0, 0, 1.3, 0, 0, 0, 0, 0.8};
+    double x[4] = {0.1, 0.2, -0.3, 0.4};
+    double y[4] = {0.3, -0.2, 0.1, 0.25};
+    double nusGeneral[4] = {-2.5, 0.5, 3.5, 7};
+    for (int k = 0; k < 4; k++) {
+        double complex refsGeneral[2] = {
+            epsteinZetaQuad(nusGeneral[k], 4, c, x, y),
+            epsteinZetaRegQuad(nusGeneral[k], 4, c, x, y)};
+        double complex vals[2] = {epsteinZeta(nusGeneral[k], 4, c, x, y),
+                                  epsteinZetaReg(nusGeneral[k], 4, c, x, y)};
+        for (int i = 0; i < 2; i++) {
+            totalTests++;
+            if (errRel(refsGeneral[i], vals[i]) < 1e-13) {
+                testsPassed++;
+            } else {
+                printf("\nWarning! nu = %lf: %.16lf %+.16lf I != %.16lf %+.16lf "
+                       "I\n",
+                       nusGeneral[k], creal(vals[i]), cimag(vals[i]),
+                       creal(refsGeneral[i]), cimag(refsGeneral[i]));
+            }
+        }
+    }
+#endif
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the gradients with respect to x and y.
+ *
+ * Compares the gradients from epsteinZetaGrad and epsteinZetaRegGrad with
+ * central differences of sixth order of epsteinZeta and epsteinZetaReg, and the
+ * returned function values with epsteinZeta and epsteinZetaReg.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaGrad() {
+    printf("Gradients ... ");
+    double a[9] = {1, 0.3, 0.1, 0, 1.2, 0.2, 0, 0, 0.9};
+    double x[3] = {0.1, 0.2, 0.3};
+    double y[3] = {0.3, -0.2, 0.1};
+    double nus[4] = {-2.5, 0.5, 2, 4.5};
+    // weights of the central difference of sixth order
+    double weights[3] = {3. / 4, -3. / 20, 1. / 60};
+    double h = 1e-3;
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int k = 0; k < 4; k++) {
+        for (int reg = 0; reg < 2; reg++) {
+            double complex grads[6];
+            double complex val =
+                reg ? epsteinZetaRegGrad(nus[k], 3, a, x, y, grads, grads + 3)
+                    : epsteinZetaGrad(nus[k], 3, a, x, y, grads, grads + 3);
+            double complex ref = reg ? epsteinZetaReg(nus[k], 3, a, x, y)
+                                     : epsteinZeta(nus[k], 3, a, x, y);
+            totalTests++;
+            if (errRel(ref, val) < 1e-14) {
+                testsPassed++;
+            } else {
+                printf("\nWarning! nu = %lf, reg = %d: %.16lf %+.16lf I != "
+                       "%.16lf %+.16lf I\n",
+                       nus[k], reg, creal(val), cimag(val), creal(ref),
+                       cimag(ref));
+            }
+            for (int i = 0; i < 6; i++) {
+                double complex diff = 0;
+                for (int j = 1; j <= 3; j++) {
+                    for (int sign = -1; sign <= 1; sign += 2) {
+                        double xh[3] = {x[0], x[1], x[2]};
+                        double yh[3] = {y[0], y[1], y[2]};
+                        if (i < 3) {
+                            xh[i] += sign * j * h;
+                        } else {
+                            yh[i - 3] += sign * j * h;
+                        }
+                        diff += sign * weights[j - 1] *
+                                (reg ? epsteinZetaReg(nus[k], 3, a, xh, yh)
+                                     : epsteinZeta(nus[k], 3, a, xh, yh));
+                    }
+                }
+                diff /= h;
+                totalTests++;
+                if (errRel(diff, grads[i]) < 1e-8) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! nu = %lf, reg = %d, derivative %d: %.16lf "
+                           "%+.16lf I != %.16lf %+.16lf I\n",
+                           nus[k], reg, i, creal(grads[i]), cimag(grads[i]),
+                           creal(diff), cimag(diff));
+                }
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the Hessians with respect to x.
+ *
+ * Compares the Hessians from epsteinZetaHessian and epsteinZetaRegHessian with
+ * central differences of sixth order of the gradients from epsteinZetaGrad and
+ * epsteinZetaRegGrad.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaHessian() {
+    printf("Hessians ... ");
+    double a[9] = {1, 0.3, 0.1, 0, 1.2, 0.2, 0, 0, 0.9};
+    double x[3] = {0.1, 0.2, 0.3};
+    double y[3] = {0.3, -0.2, 0.1};
+    double nus[4] = {-2.5, 0.5, 2, 4.5};
+    // weights of the central difference of sixth order
+    double weights[3] = {3. / 4, -3. / 20, 1. / 60};
+    double h = 1e-3;
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int k = 0; k < 4; k++) {
+        for (int reg = 0; reg < 2; reg++) {
+            double complex grad[3];
+            double complex hess[9];
+            if (reg) {
+                epsteinZetaRegHessian(nus[k], 3, a, x, y, grad, hess);
+            } else {
+                epsteinZetaHessian(nus[k], 3, a, x, y, grad, hess);
+            }
+            // central differences of the gradients along the axis j
+            for (int j = 0; j < 3; j++) {
+                double complex diff[3] = {0, 0, 0};
+                for (int l = 1; l <= 3; l++) {
+                    for (int sign = -1; sign <= 1; sign += 2) {
+                        double xh[3] = {x[0], x[1], x[2]};
+                        xh[j] += sign * l * h;
+                        double complex gradX[3];
+                        double complex gradY[3];
+                        if (reg) {
+                            epsteinZetaRegGrad(nus[k], 3, a, xh, y, gradX, gradY);
+                        } else {
+                            epsteinZetaGrad(nus[k], 3, a, xh, y, gradX, gradY);
+                        }
+                        for (int i = 0; i < 3; i++) {
+                            diff[i] += sign * weights[l - 1] * gradX[i] / h;
+                        }
+                    }
+                }
+                for (int i = 0; i < 3; i++) {
+                    totalTests++;
+                    if (errRel(diff[i], hess[3 * i + j]) < 1e-8) {
+                        testsPassed++;
+                    } else {
+                        printf("\nWarning! nu = %lf, reg = %d, derivative %d %d: "
+                               "%.16lf %+.16lf I != %.16lf %+.16lf I\n",
+                               nus[k], reg, i, j, creal(hess[3 * i + j]),
+                               cimag(hess[3 * i + j]), creal(diff[i]),
+                               cimag(diff[i]));
+                    }
+                }
+            }
+        }
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
+/*!
+ * @brief Test function for the Taylor coefficients in the exponent.
+ *
+ * Compares the Taylor polynomials from epsteinZetaTaylorNu and
+ * epsteinZetaRegTaylorNu with epsteinZeta and epsteinZetaReg at and close to
+ * the expansion point, and checks that the coefficients are NAN at the poles.
+ *
+ * @return 0 if all tests pass, 1 if any test fails.
+ */
+int test_epsteinZetaTaylorNu() {
+    printf("Taylor coefficients in nu ... ");
+    double a[9] = {1, 0.3, 0.1, 0, 1.2, 0.2, 0, 0, 0.9};
+    double x[3] = {0.1, 0.2, 0.3};
+    double y[3] = {0.3, -0.2, 0.1};
+    double zero[3] = {0, 0, 0};
+    double nus[4] = {-2.5, 0.5, 2.5, 4.5};
+    double hs[3] = {-0.02, 0.01, 0.02};
+    const unsigned int n = 8;
+    int testsPassed = 0;
+    int totalTests = 0;
+    for (int k = 0; k < 4; k++) {
+        for (int reg = 0; reg < 2; reg++) {
+            double complex coeffs[n];
+            if (reg) {
+                epsteinZetaRegTaylorNu(nus[k], 3, a, x, y, n, coeffs);
+            } else {
+                epsteinZetaTaylorNu(nus[k], 3, a, x, y, n, coeffs);
+            }
+            // the Taylor polynomial has to match the function in a neighbourhood
+            // of nu
+            for (int l = 0; l < 4; l++) {
+                double h = (l == 0) ? 0 : hs[l - 1];
+                double complex ref = reg
+                                         ? epsteinZetaReg(nus[k] + h, 3, a, x, y)
+                                         : epsteinZeta(nus[k] + h, 3, a, x, y);
+                double complex sum = 0;
+                for (int j = n - 1; j >= 0; j--) {
+                    sum = sum * h + coeffs[j];
+                }
+                totalTests++;
+                if (errRel(ref, sum) < 1e-10) {
+                    testsPassed++;
+                } else {
+                    printf("\nWarning! nu = %lf, reg = %d, h = %lf: "
+                           "%.16lf %+.16lf I != %.16lf %+.16lf I\n",
+                           nus[k], reg, h, creal(sum), cimag(sum), creal(ref),
+                           cimag(ref));
+                }
+            }
+        }
+    }
+    // no coefficients are requested
+    for (int reg = 0; reg < 2; reg++) {
+        double complex untouched = 1;
+        int status = reg ? epsteinZetaRegTaylorNu(0.5, 3, a, x, y, 0, &untouched)
+                         : epsteinZetaTaylorNu(0.5, 3, a, x, y, 0, &untouched);
+        totalTests++;
+        if (status == 0 && untouched == 1) {
+            testsPassed++;
+        } else {
+            printf("\nWarning! reg = %d: n = 0 returned %d and wrote the output.\n",
+                   reg, status);
+        }
+    }
+    // the coefficients are NAN at the poles
+    double complex coeffs[n];
+    epsteinZetaTaylorNu(3, 3, a, x, zero, n, coeffs);
+    totalTests++;
+    if (isnan(creal(coeffs[0]))) {
+        testsPassed++;
+    } else {
+        printf("\nWarning! no pole at nu = 3.\n");
+    }
+    epsteinZetaRegTaylorNu(5, 3, a, x, y, n, coeffs);
+    totalTests++;
+    if (isnan(creal(coeffs[0]))) {
+        testsPassed++;
+    } else {
+        printf("\nWarning! no pole of the regularization at nu = 5.\n");
+    }
+    printf("%d out of %d tests passed.\n", testsPassed, totalTests);
+    return (testsPassed == totalTests) ? 0 : 1;
+}
+
 int main() {
     int result = test_epsteinZeta_epsteinZetaReg();
+    result |= test_epsteinZetaPlan();
+    result |= test_epsteinZetaBatch();
+    result |= test_epsteinZetaBatchNu();
+    result |= test_epsteinZetaThreads();
+    result |= test_epsteinZetaBatchTasks();
+    result |= test_epsteinZetaSkewedBasis();
+    result |= test_epsteinZetaLambda();
+    result |= test_epsteinZetaTol();
+    result |= test_epsteinZetaFloat();
+    result |= test_epsteinZetaQuad();
+    result |= test_epsteinZetaSymmetric();
+    result |= test_epsteinZetaTabulated();
+    result |= test_epsteinZeta1d();
+    result |= test_epsteinZetaBlockDiagonal();
+    result |= test_epsteinZetaGrad();
+    result |= test_epsteinZetaHessian();
+    result |= test_epsteinZetaTaylorNu();
     return result;
 }
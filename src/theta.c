@@ -0,0 +1,400 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file theta.c
+ * @brief Calculates the sums in Crandall's formula for block diagonal lattices
+ * as Mellin integrals over products of the theta functions of the blocks.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "crandall.h"
+#include "lattice.h"
+#include "theta.h"
+#include "tools.h"
+#include "zeta.h"
+
+/*!
+ * @brief step of the trapezoidal rule after the double exponential
+ * transformation.
+ */
+#define THETA_STEP 0.125
+
+/*!
+ * @brief first node of the trapezoidal rule, the transformed integrand is below
+ * exp(-exp(-THETA_U_MIN)) there.
+ */
+#define THETA_U_MIN -4.
+
+/*!
+ * @brief last node of the trapezoidal rule, the integrand decays at least like
+ * exp(-exp(THETA_U_MAX)) there.
+ */
+#define THETA_U_MAX 6.
+
+/*!
+ * @brief number of nodes of the quadrature.
+ */
+#define THETA_NODES ((int)((THETA_U_MAX - THETA_U_MIN) / THETA_STEP) + 1)
+
+/*!
+ * @brief cost of one point of a block at one node of the quadrature relative to
+ * one summand of the sums in Crandall's formula.
+ */
+#define THETA_COST 0.1
+
+/*!
+ * @brief exponent, beyond which the summands of a block are negligible compared
+ * to the summand of its closest point.
+ */
+#define THETA_ARG 40.
+
+/**
+ * @brief finds the representative of an axis in a union-find forest.
+ * @param[in, out] parent: parent of each axis, compressed on the way.
+ * @param[in] i: axis.
+ * @return representative of the set of i.
+ */
+int theta_find(int *parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/**
+ * @brief joins the rows of the nonzero entries of every column of a matrix.
+ * @param[in] dim: dimension of the matrix.
+ * @param[in] m: matrix.
+ * @param[in, out] parent: union-find forest of the axes.
+ */
+void theta_join(unsigned int dim, const double *m, int *parent) {
+    for (int j = 0; j < dim; j++) {
+        int first = -1;
+        for (int i = 0; i < dim; i++) {
+            if (m[dim * i + j] == 0) {
+                continue;
+            }
+            if (first < 0) {
+                first = i;
+                continue;
+            }
+            // the smaller root becomes the root of the union
+            int a = theta_find(parent, first);
+            int b = theta_find(parent, i);
+            if (a < b) {
+                parent[b] = a;
+            } else {
+                parent[a] = b;
+            }
+        }
+    }
+}
+
+/**
+ * @brief splits the axes into the blocks of a block diagonal lattice, such that
+ * every column of both matrices only has nonzero entries in the rows of one
+ * block.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m_real: matrix that transforms the lattice.
+ * @param[in] m_fourier: matrix that transforms the reciprocal lattice.
+ * @param[out] axisBlock: block of each axis, numbered by their first axis.
+ * @return number of blocks, 1 if the lattice is not block diagonal.
+ */
+unsigned int theta_blocks(unsigned int dim, const double *m_real,
+                          const double *m_fourier, int *axisBlock) {
+    int parent[dim];
+    for (int i = 0; i < dim; i++) {
+        parent[i] = i;
+    }
+    theta_join(dim, m_real, parent);
+    theta_join(dim, m_fourier, parent);
+    unsigned int nBlocks = 0;
+    for (int i = 0; i < dim; i++) {
+        int root = theta_find(parent, i);
+        if (root == i) {
+            axisBlock[i] = nBlocks++;
+        } else {
+            // the root is the smallest axis of its set and numbered already
+            axisBlock[i] = axisBlock[root];
+        }
+    }
+    return nBlocks;
+}
+
+/**
+ * @brief extracts the matrix of one block of a block diagonal matrix.
+ * @param[in] dim: dimension of the matrix.
+ * @param[in] m: block diagonal matrix.
+ * @param[in] axisBlock: block of each axis from theta_blocks.
+ * @param[in] block: block to extract.
+ * @param[out] axes: axes of the block.
+ * @param[out] mb: matrix of the block, rows in axes and the columns whose
+ * nonzero entries are in these rows.
+ * @return dimension of the block.
+ */
+unsigned int theta_blockMatrix(unsigned int dim, const double *m,
+                               const int *axisBlock, int block, int *axes,
+                               double *mb) {
+    unsigned int dimBlock = 0;
+    for (int i = 0; i < dim; i++) {
+        if (axisBlock[i] == block) {
+            axes[dimBlock++] = i;
+        }
+    }
+    int column = 0;
+    for (int j = 0; j < dim; j++) {
+        int i = 0;
+        while (i < dim && m[dim * i + j] == 0) {
+            i++;
+        }
+        if (i == dim || axisBlock[i] != block) {
+            continue;
+        }
+        for (int k = 0; k < dimBlock; k++) {
+            mb[dimBlock * k + column] = m[dim * axes[k] + j];
+        }
+        column++;
+    }
+    return dimBlock;
+}
+
+/**
+ * @brief estimates whether the theta functions of the blocks are cheaper than
+ * the lattice sums in Crandall's formula.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m_real: matrix that transforms the lattice of unit volume.
+ * @param[in] radiusReal: cutoff radius of the first sum.
+ * @param[in] radiusFourier: cutoff radius of the second sum.
+ * @param[in] nBlocks: number of blocks from theta_blocks.
+ * @param[in] axisBlock: block of each axis from theta_blocks.
+ * @return true if theta_sum is estimated to be faster.
+ */
+bool theta_faster(unsigned int dim, const double *m_real, double radiusReal,
+                  double radiusFourier, unsigned int nBlocks,
+                  const int *axisBlock) {
+    if (nBlocks < 2) {
+        return false;
+    }
+    double count = 0;
+    for (int b = 0; b < nBlocks; b++) {
+        int axes[dim];
+        double mb[dim * dim];
+        double r[dim * dim];
+        unsigned int dimBlock =
+            theta_blockMatrix(dim, m_real, axisBlock, b, axes, mb);
+        latticeCholesky(dimBlock, mb, r);
+        double vol = 1;
+        for (int k = 0; k < dimBlock; k++) {
+            vol *= fabs(r[dimBlock * k + k]);
+        }
+        // the reciprocal lattice of the block has the inverse volume
+        count += ballVolume(dimBlock, radiusReal) / vol +
+                 ballVolume(dimBlock, radiusFourier) * vol + 2;
+    }
+    return THETA_NODES * THETA_COST * count <
+           ballVolume(dim, radiusReal) + ballVolume(dim, radiusFourier);
+}
+
+/**
+ * @brief squared norm and phase of one point of a block.
+ */
+struct thetaPoint {
+    double r2; //!< squared norm of the shifted point.
+    double re; //!< real part of the phase.
+    double im; //!< imaginary part of the phase.
+};
+
+/**
+ * @brief points of one block within the cutoff radius, sorted by their norms.
+ */
+struct thetaBlock {
+    long n;                    //!< number of points without zv = 0.
+    bool zero;                 //!< true if zv = 0 is enumerated.
+    double shift2;             //!< squared norm of the shift of the block.
+    struct thetaPoint *points; //!< points without zv = 0.
+};
+
+/**
+ * @brief compares two points of a block by their squared norms.
+ * @param[in] a: first point.
+ * @param[in] b: second point.
+ * @return -1, 0 or 1 if the first norm is smaller, equal or larger.
+ */
+int theta_pointCompare(const void *a, const void *b) {
+    double r2a = ((const struct thetaPoint *)a)->r2;
+    double r2b = ((const struct thetaPoint *)b)->r2;
+    return (r2a > r2b) - (r2a < r2b);
+}
+
+/**
+ * @brief enumerates the points of one block within the cutoff radius.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: block diagonal matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase.
+ * @param[in] radius: cutoff radius.
+ * @param[in] axisBlock: block of each axis from theta_blocks.
+ * @param[in] b: block to enumerate.
+ * @param[out] block: points of the block, block->points has to be freed.
+ * @return 0 on success, 1 if memory allocation fails.
+ */
+int theta_blockCreate(unsigned int dim, const double *m, const double *shift,
+                      const double *w, double radius, const int *axisBlock,
+                      int b, struct thetaBlock *block) {
+    int axes[dim];
+    double mb[dim * dim];
+    unsigned int dimBlock = theta_blockMatrix(dim, m, axisBlock, b, axes, mb);
+    double shiftBlock[dimBlock];
+    double wBlock[dimBlock];
+    for (int k = 0; k < dimBlock; k++) {
+        shiftBlock[k] = shift[axes[k]];
+        wBlock[k] = w[axes[k]];
+    }
+    block->points = NULL;
+    block->shift2 = dot(dimBlock, shiftBlock, shiftBlock);
+    struct latticeRows *rows = latticeRowsCreate(dimBlock, mb, shiftBlock, radius);
+    struct latticeWalker *walker =
+        rows == NULL ? NULL
+                     : latticeWalkerCreate(dimBlock, mb, shiftBlock, rows,
+                                           INFINITY, 0);
+    if (walker != NULL) {
+        block->points = malloc(rows->nPoints * sizeof(struct thetaPoint));
+    }
+    if (block->points == NULL) {
+        latticeWalkerFree(walker);
+        latticeRowsFree(rows);
+        return 1;
+    }
+    block->n = 0;
+    block->zero = rows->zeroIndex >= 0;
+    double shiftPhase = dot(dimBlock, shiftBlock, wBlock);
+    for (long n = 0; n < rows->nPoints; n++, latticeWalkerNext(walker)) {
+        // the summand for zv = 0 does not decay for a zero shift, subtracting
+        // it from the theta function would leave its rounding error
+        if (n == rows->zeroIndex) {
+            continue;
+        }
+        // (m zv) * w = (m zv + shift) * w - shift * w
+        double phase = -2 * M_PI * (dot(dimBlock, walker->v, wBlock) - shiftPhase);
+        struct thetaPoint *point = block->points + block->n++;
+        point->r2 = walker->r2;
+        point->re = cos(phase);
+        point->im = sin(phase);
+    }
+    qsort(block->points, block->n, sizeof(struct thetaPoint), theta_pointCompare);
+    latticeWalkerFree(walker);
+    latticeRowsFree(rows);
+    return 0;
+}
+
+/**
+ * @brief calculates one of the sums in Crandall's formula for a block diagonal
+ * lattice. With G(t) = int_1^infinity s^(nu / 2 - 1) exp(-s t) ds, the sum is the
+ * integral of s^(nu / 2 - 1) times the theta function of the lattice, which is
+ * the product of the theta functions of the blocks. The summand for zv = 0 is
+ * split off and the integral over the rest is evaluated with a double
+ * exponential quadrature.
+ * @param[in] nu: exponent of G.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: block diagonal matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase.
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] radius: cutoff radius of the points in every block.
+ * @param[in] skipZero: true to skip the summand for zv = 0.
+ * @param[in] zArgBound: bound on when to use the asymptotic expansion in G.
+ * @param[in] nBlocks: number of blocks from theta_blocks.
+ * @param[in] axisBlock: block of each axis from theta_blocks.
+ * @return sum_{zv} G(argScale |m zv + shift|^2) exp(-2 * PI * I * (m zv) * w),
+ * NAN if memory allocation fails.
+ */
+double complex theta_sum(double nu, unsigned int dim, const double *m,
+                         const double *shift, const double *w, double argScale,
+                         double radius, bool skipZero, double zArgBound,
+                         unsigned int nBlocks, const int *axisBlock) {
+    struct thetaBlock blocks[nBlocks];
+    bool failed = false;
+    for (int b = 0; b < nBlocks; b++) {
+        failed = failed || theta_blockCreate(dim, m, shift, w, radius, axisBlock, b,
+                                             blocks + b) != 0;
+        if (failed) {
+            blocks[b].points = NULL;
+        }
+    }
+    double complex sum = NAN;
+    if (!failed) {
+        // the rest decays like exp(-t * argScale * r1^2) with the distance r1 of
+        // the second closest point, which scales the quadrature
+        double shift2 = 0;
+        double gap = INFINITY;
+        bool zeroFound = true;
+        for (int b = 0; b < nBlocks; b++) {
+            shift2 += blocks[b].shift2;
+            zeroFound = zeroFound && blocks[b].zero;
+            if (blocks[b].n > 0) {
+                gap = fmin(gap, blocks[b].points[0].r2 - blocks[b].shift2);
+            }
+        }
+        double decay = argScale * (shift2 + gap);
+        if (!(decay > 0 && decay < INFINITY)) {
+            decay = argScale;
+        }
+        sum = 0;
+        for (int k = 0; k < THETA_NODES; k++) {
+            // t = 1 + exp(u - exp(-u)) / decay
+            double u = THETA_U_MIN + k * THETA_STEP;
+            double tau = exp(u - exp(-u)) / decay;
+            double t = 1 + tau;
+            // prod (z_b + r_b) - prod z_b with the summands z_b for zv = 0, such
+            // that the rest is accumulated without cancellation
+            double complex rest = 0;
+            double zeros = 1;
+            for (int b = 0; b < nBlocks; b++) {
+                const struct thetaBlock *block = blocks + b;
+                double re = 0;
+                double im = 0;
+                if (block->n > 0) {
+                    // the points are sorted, stop when they are negligible
+                    // compared to the closest one
+                    double argMax = argScale * t * block->points[0].r2 + THETA_ARG;
+                    for (long n = 0; n < block->n; n++) {
+                        double arg = argScale * t * block->points[n].r2;
+                        if (arg > argMax) {
+                            break;
+                        }
+                        double e = exp(-arg);
+                        re += block->points[n].re * e;
+                        im += block->points[n].im * e;
+                    }
+                }
+                double z = block->zero ? exp(-argScale * t * block->shift2) : 0;
+                rest = rest * (z + re + I * im) + zeros * (re + I * im);
+                zeros *= z;
+            }
+            sum += THETA_STEP * tau * (1 + exp(-u)) * pow(t, nu / 2 - 1) * rest;
+        }
+        if (!skipZero && zeroFound) {
+            sum += crandall_gArg(nu, argScale * shift2, zArgBound);
+        }
+    }
+    for (int b = 0; b < nBlocks; b++) {
+        free(blocks[b].points);
+    }
+    return sum;
+}
+#undef THETA_STEP
+#undef THETA_U_MIN
+#undef THETA_U_MAX
+#undef THETA_NODES
+#undef THETA_COST
+#undef THETA_ARG
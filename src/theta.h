@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file theta.h
+ * @brief Calculates the sums in Crandall's formula for block diagonal lattices
+ * as Mellin integrals over products of the theta functions of the blocks.
+ */
+
+#ifndef THETA_H
+#define THETA_H
+#include <complex.h>
+#include <stdbool.h>
+
+/**
+ * @brief splits the axes into the blocks of a block diagonal lattice, such that
+ * every column of both matrices only has nonzero entries in the rows of one
+ * block.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m_real: matrix that transforms the lattice.
+ * @param[in] m_fourier: matrix that transforms the reciprocal lattice.
+ * @param[out] axisBlock: block of each axis, numbered by their first axis.
+ * @return number of blocks, 1 if the lattice is not block diagonal.
+ */
+unsigned int theta_blocks(unsigned int dim, const double *m_real,
+                          const double *m_fourier, int *axisBlock);
+
+/**
+ * @brief estimates whether the theta functions of the blocks are cheaper than
+ * the lattice sums in Crandall's formula.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m_real: matrix that transforms the lattice of unit volume.
+ * @param[in] radiusReal: cutoff radius of the first sum.
+ * @param[in] radiusFourier: cutoff radius of the second sum.
+ * @param[in] nBlocks: number of blocks from theta_blocks.
+ * @param[in] axisBlock: block of each axis from theta_blocks.
+ * @return true if theta_sum is estimated to be faster.
+ */
+bool theta_faster(unsigned int dim, const double *m_real, double radiusReal,
+                  double radiusFourier, unsigned int nBlocks,
+                  const int *axisBlock);
+
+/**
+ * @brief calculates one of the sums in Crandall's formula for a block diagonal
+ * lattice. With G(t) = int_1^infinity s^(nu / 2 - 1) exp(-s t) ds, the sum is the
+ * integral of s^(nu / 2 - 1) times the theta function of the lattice, which is
+ * the product of the theta functions of the blocks. The summand for zv = 0 is
+ * split off and the integral over the rest is evaluated with a double
+ * exponential quadrature.
+ * @param[in] nu: exponent of G.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: block diagonal matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase.
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] radius: cutoff radius of the points in every block.
+ * @param[in] skipZero: true to skip the summand for zv = 0.
+ * @param[in] zArgBound: bound on when to use the asymptotic expansion in G.
+ * @param[in] nBlocks: number of blocks from theta_blocks.
+ * @param[in] axisBlock: block of each axis from theta_blocks.
+ * @return sum_{zv} G(argScale |m zv + shift|^2) exp(-2 * PI * I * (m zv) * w),
+ * NAN if memory allocation fails.
+ */
+double complex theta_sum(double nu, unsigned int dim, const double *m,
+                         const double *shift, const double *w, double argScale,
+                         double radius, bool skipZero, double zArgBound,
+                         unsigned int nBlocks, const int *axisBlock);
+#endif
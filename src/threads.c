@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file threads.c
+ * @brief Runtime configuration of the thread count and a minimal fork-join
+ * helper for splitting the lattice sums across threads.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "threads.h"
+
+/*!
+ * @brief number of threads used within a single evaluation, threading is
+ * opt-in.
+ */
+unsigned int threadsNum = 1;
+
+/*!
+ * @brief true on threads that execute tasks of a pool.
+ */
+_Thread_local bool threadsInPool = false;
+
+/**
+ * @brief sets the number of threads used within a single evaluation.
+ * @param[in] n: number of threads, 0 and 1 both disable threading.
+ */
+void threadsSetNum(unsigned int n) { threadsNum = (n == 0) ? 1 : n; }
+
+/**
+ * @brief gets the number of threads used within a single evaluation.
+ * @return number of threads, at least 1, and 1 on threads of a pool.
+ */
+unsigned int threadsGetNum(void) { return threadsInPool ? 1 : threadsNum; }
+
+/**
+ * @brief runs a task for each of n arguments concurrently and waits for all of
+ * them. The first task runs on the calling thread. Tasks whose thread cannot be
+ * started also run on the calling thread, so all tasks are always completed.
+ * @param[in] n: number of tasks.
+ * @param[in] task: function that is called with a pointer to each argument.
+ * @param[in, out] args: n arguments of size argSize, stored one after another.
+ * @param[in] argSize: size of one argument in bytes.
+ */
+void threadsRun(unsigned int n, void *(*task)(void *), void *args, size_t argSize) {
+    if (n == 0) {
+        return;
+    }
+    char *argv = args;
+    pthread_t threads[n];
+    bool started[n];
+    for (unsigned int i = 1; i < n; i++) {
+        started[i] =
+            pthread_create(threads + i, NULL, task, argv + i * argSize) == 0;
+    }
+    task(argv);
+    for (unsigned int i = 1; i < n; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            task(argv + i * argSize);
+        }
+    }
+}
+
+/**
+ * @brief deque of tasks of one thread in a pool. Thread t owns the positions
+ * t + k * n of the task order for head <= k < tail.
+ */
+struct threadsDeque {
+    pthread_mutex_t lock; //!< guards head and tail.
+    long head;            //!< next position the owner takes.
+    long tail;            //!< position after the last one thieves take.
+};
+
+/**
+ * @brief shared state of a work-stealing pool.
+ */
+struct threadsPool {
+    unsigned int n;              //!< number of threads.
+    const long *order;           //!< order of the tasks.
+    void (*task)(void *, long);  //!< function that runs a task.
+    void *ctx;                   //!< data shared by all tasks.
+    struct threadsDeque *deques; //!< one deque per thread.
+};
+
+/**
+ * @brief argument of one thread of a pool.
+ */
+struct threadsWorker {
+    struct threadsPool *pool; //!< shared state of the pool.
+    unsigned int id;          //!< index of the thread and its deque.
+};
+
+/**
+ * @brief takes a task from a deque.
+ * @param[in, out] deque: deque to take the task from.
+ * @param[in] front: true to take from the front, false to take from the back.
+ * @param[out] k: position of the task in the deque.
+ * @return true if a task was taken, false if the deque is empty.
+ */
+bool threadsDequePop(struct threadsDeque *deque, bool front, long *k) {
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->head < deque->tail) {
+        *k = front ? deque->head++ : --deque->tail;
+        found = true;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+/**
+ * @brief runs tasks of a pool until all deques are empty.
+ * @param[in] arg: pointer to a struct threadsWorker.
+ * @return NULL
+ */
+void *threadsWorkerRun(void *arg) {
+    struct threadsWorker *worker = arg;
+    struct threadsPool *pool = worker->pool;
+    unsigned int n = pool->n;
+    bool inPool = threadsInPool;
+    threadsInPool = true;
+    for (;;) {
+        long k;
+        unsigned int owner = worker->id;
+        bool found = threadsDequePop(pool->deques + owner, true, &k);
+        for (unsigned int v = 1; !found && v < n; v++) {
+            owner = (worker->id + v) % n;
+            found = threadsDequePop(pool->deques + owner, false, &k);
+        }
+        if (!found) {
+            break;
+        }
+        pool->task(pool->ctx, pool->order[owner + k * n]);
+    }
+    threadsInPool = inPool;
+    return NULL;
+}
+
+/**
+ * @brief runs independent tasks on a work-stealing pool of threadsGetNum()
+ * threads. The tasks are dealt round-robin to one deque per thread in the given
+ * order. Every thread takes tasks from the front of its own deque and, once it
+ * is empty, steals from the back of the other deques. Within the pool,
+ * threadsGetNum() returns 1, so the tasks do not start threads themselves.
+ * @param[in] nTasks: number of tasks.
+ * @param[in] order: order in which the tasks should be started, e.g. by
+ * decreasing cost.
+ * @param[in] task: function that is called with ctx and the index of the task.
+ * @param[in, out] ctx: data shared by all tasks.
+ */
+void threadsRunPool(long nTasks, const long *order, void (*task)(void *, long),
+                    void *ctx) {
+    long n = threadsGetNum();
+    if (nTasks < n) {
+        n = nTasks;
+    }
+    if (n <= 1) {
+        for (long i = 0; i < nTasks; i++) {
+            task(ctx, order[i]);
+        }
+        return;
+    }
+    struct threadsDeque deques[n];
+    struct threadsWorker workers[n];
+    struct threadsPool pool = {n, order, task, ctx, deques};
+    for (long t = 0; t < n; t++) {
+        pthread_mutex_init(&deques[t].lock, NULL);
+        deques[t].head = 0;
+        deques[t].tail = (nTasks - t + n - 1) / n;
+        workers[t] = (struct threadsWorker){&pool, t};
+    }
+    threadsRun(n, threadsWorkerRun, workers, sizeof(struct threadsWorker));
+    for (long t = 0; t < n; t++) {
+        pthread_mutex_destroy(&deques[t].lock);
+    }
+}
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file threads.h
+ * @brief Runtime configuration of the thread count and a minimal fork-join
+ * helper for splitting the lattice sums across threads.
+ */
+
+#ifndef THREADS_H
+#define THREADS_H
+#include <stddef.h>
+
+/**
+ * @brief sets the number of threads used within a single evaluation.
+ * @param[in] n: number of threads, 0 and 1 both disable threading.
+ */
+void threadsSetNum(unsigned int n);
+
+/**
+ * @brief gets the number of threads used within a single evaluation.
+ * @return number of threads, at least 1.
+ */
+unsigned int threadsGetNum(void);
+
+/**
+ * @brief runs a task for each of n arguments concurrently and waits for all of
+ * them. The first task runs on the calling thread. Tasks whose thread cannot be
+ * started also run on the calling thread, so all tasks are always completed.
+ * @param[in] n: number of tasks.
+ * @param[in] task: function that is called with a pointer to each argument.
+ * @param[in, out] args: n arguments of size argSize, stored one after another.
+ * @param[in] argSize: size of one argument in bytes.
+ */
+void threadsRun(unsigned int n, void *(*task)(void *), void *args, size_t argSize);
+
+/**
+ * @brief runs independent tasks on a work-stealing pool of threadsGetNum()
+ * threads. The tasks are dealt round-robin to one deque per thread in the given
+ * order. Every thread takes tasks from the front of its own deque and, once it
+ * is empty, steals from the back of the other deques. Within the pool,
+ * threadsGetNum() returns 1, so the tasks do not start threads themselves.
+ * @param[in] nTasks: number of tasks.
+ * @param[in] order: order in which the tasks should be started, e.g. by
+ * decreasing cost.
+ * @param[in] task: function that is called with ctx and the index of the task.
+ * @param[in, out] ctx: data shared by all tasks.
+ */
+void threadsRunPool(long nTasks, const long *order, void (*task)(void *, long),
+                    void *ctx);
+#endif
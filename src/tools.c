@@ -110,7 +110,7 @@ void invert(unsigned int dim, double *m, int *p, double *r) { // NOLINT
         // column pivot search
         int r = i;
         for (int j = i + 1; j < dim; j++) {
-            if (fabs(m[i * dim + j]) > fabs(m[i * dim + r])) {
+            if (fabs(m[j * dim + i]) > fabs(m[r * dim + i])) {
                 r = j;
             }
         }
@@ -133,17 +133,21 @@ void invert(unsigned int dim, double *m, int *p, double *r) { // NOLINT
             }
         }
     }
-    // Compute inverse
+    // Compute inverse, row k of the decomposed matrix is row p[k] of m
     double y[dim]; // NOLINT user has to provide dim > 0
+    int pinv[dim]; // NOLINT
+    for (int k = 0; k < dim; k++) {
+        pinv[p[k]] = k;
+    }
     for (int i = 0; i < dim; i++) {
-        // Solve Ly=e_p[i]
-        for (int j = 0; j < p[i]; j++) {
+        // Solve Ly=Pe_i
+        for (int j = 0; j < pinv[i]; j++) {
             y[j] = 0;
         }
-        y[p[i]] = 1;
-        for (int k = p[i] + 1; k < dim; k++) {
+        y[pinv[i]] = 1;
+        for (int k = pinv[i] + 1; k < dim; k++) {
             y[k] = 0;
-            for (int j = p[i]; j < k; j++) {
+            for (int j = pinv[i]; j < k; j++) {
                 y[k] -= m[k * dim + j] * y[j];
             }
         }
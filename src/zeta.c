@@ -16,6 +16,9 @@
 #include <stdlib.h>
 
 #include "crandall.h"
+#include "lattice.h"
+#include "theta.h"
+#include "threads.h"
 #include "tools.h"
 
 #include "zeta.h"
@@ -31,6 +34,90 @@
  */
 #define EPS ldexp(1, -30)
 
+/*!
+ * @brief the weight lambda is chosen from 2^(k / LAMBDA_STEPS) for
+ * |k| <= LAMBDA_OCTAVES * LAMBDA_STEPS.
+ */
+#define LAMBDA_STEPS 8
+
+/*!
+ * @brief number of octaves around lambda = 1 in which lambda is chosen, outside
+ * of them the prefactors of the sums in Crandall's formula lose accuracy.
+ */
+#define LAMBDA_OCTAVES 2
+
+/*!
+ * @brief minimal number of summands per thread, below which starting another
+ * thread does not pay off.
+ */
+#define MIN_SUMMANDS_THREAD 4096
+
+/*!
+ * @brief number of summands for which G is evaluated at once.
+ */
+#define G_BLOCK 32
+
+/**
+ * @brief number of entries in the phase tables of enumerated lattice points.
+ * @param[in] rows: enumerated lattice points.
+ * @return sum_k (upper[k] - lower[k] + 1)
+ */
+long phaseTableSize(const struct latticeRows *rows) {
+    long size = 0;
+    for (int k = 0; k < rows->dim; k++) {
+        size += rows->upper[k] - rows->lower[k] + 1;
+    }
+    return size;
+}
+
+/**
+ * @brief precomputes the phases of enumerated summands along each axis. The
+ * phase exp(-2 * PI * I * (m zv) * w) of a summand factors into
+ * prod_k exp(-2 * PI * I * zv[k] * (m^T w)[k]), so every phase is a product of
+ * dim table entries.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] w: vector in the phase.
+ * @param[in] rows: enumerated lattice points.
+ * @param[out] phases: for each axis k, the phases for zv[k] = lower[k], ...,
+ * upper[k], stored one after another.
+ * @param[out] offsets: index of the first phase of each axis in phases.
+ */
+void phaseTable(unsigned int dim, const double *m, const double *w,
+                const struct latticeRows *rows, double complex *phases,
+                long *offsets) {
+    long offset = 0;
+    for (int k = 0; k < dim; k++) {
+        double mw = 0;
+        for (int i = 0; i < dim; i++) {
+            mw += m[i * dim + k] * w[i];
+        }
+        offsets[k] = offset;
+        for (int c = rows->lower[k]; c <= rows->upper[k]; c++) {
+            phases[offset++] = cexp(-2 * M_PI * I * c * mw);
+        }
+    }
+}
+
+/**
+ * @brief multiplies the phases of all axes but the first from a phase table.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] zv: counting vector of the summand.
+ * @param[in] rows: enumerated lattice points.
+ * @param[in] phases: phase table computed by phaseTable.
+ * @param[in] offsets: offsets computed by phaseTable.
+ * @return prod_{k > 0} exp(-2 * PI * I * zv[k] * (m^T w)[k])
+ */
+double complex phaseOuter(unsigned int dim, const int *zv,
+                          const struct latticeRows *rows,
+                          const double complex *phases, const long *offsets) {
+    double complex rot = 1;
+    for (int k = 1; k < dim; k++) {
+        rot *= phases[offsets[k] + zv[k] - rows->lower[k]];
+    }
+    return rot;
+}
+
 /**
  * @brief calculates the first sum in Crandall's formula.
  * @param[in] nu: exponent for the Epstein zeta function.
@@ -40,46 +127,68 @@
  * function.
  * @param[in] x: projection of x vector to elementary lattice cell.
  * @param[in] y: projection of y vector to elementary lattice cell.
- * @param[in] cutoffs: how many summands in each direction are considered.
+ * @param[in] rows: lattice points z - x within the cutoff radius, enumerated
+ * with latticeRowsCreate for the shift -x.
  * @param[in] zArgBound: global bound on when to use the asymptotic expansion in
  * the incomplete gamma evaluation.
+ * @param[in] gamma: constants of the upper incomplete gamma function in G.
+ * @param[in] gTable: table of G from crandall_gTableCreate, or NULL.
+ * @param[in] begin: first flat index of the rows that is summed.
+ * @param[in] end: flat index after the last index that is summed.
  * @return helper function for the first sum in crandalls formula. Calculates
  * sum_{z in m whole_numbers ** dim} G_{nu}((z - x) / lambda))
  * X exp(-2 * PI * I * z * y)
  */
 double complex sum_real(double nu, unsigned int dim, double lambda, const double *m,
-                        const double *x, const double *y, const int cutoffs[],
-                        double zArgBound) {
-    int zv[dim];    // counting vector in Z^dim
-    double lv[dim]; // lattice vector
-    // cuboid cutoffs
-    long totalSummands = 1;
-    long totalCutoffs[dim + 1];
-    for (int k = 0; k < dim; k++) {
-        totalCutoffs[k] = totalSummands;
-        totalSummands *= 2 * cutoffs[k] + 1;
-    }
+                        const double *x, const double *y,
+                        const struct latticeRows *rows, double zArgBound,
+                        const struct egfContext *gamma,
+                        const struct crandallGTable *gTable, long begin,
+                        long end) {
     double complex sum = 0.0;
     double complex epsilon = 0.0;
     double complex auxt;
     double complex auxy;
+    double prefactor = 1. / lambda;
+    double complex rots[G_BLOCK];
+    double zArguments[G_BLOCK];
+    double gs[G_BLOCK];
+    double complex phases[phaseTableSize(rows)];
+    long offsets[dim];
+    phaseTable(dim, m, y, rows, phases, offsets);
+    double shift[dim];
+    for (int i = 0; i < dim; i++) {
+        shift[i] = -x[i];
+    }
+    double argScale = M_PI * prefactor * prefactor;
+    struct latticeWalker *walker = latticeWalkerCreate(
+        dim, m, shift, rows, LATTICE_EXACT_ARG / argScale, begin);
+    if (walker == NULL) {
+        return NAN;
+    }
+    double complex rotOuter =
+        phaseOuter(dim, walker->zv, rows, phases, offsets);
     // First Sum (in real space)
-    for (long n = 0; n < totalSummands; n++) {
-        for (int k = 0; k < dim; k++) {
-            zv[k] =
-                (((int)(n / totalCutoffs[k])) % (2 * cutoffs[k] + 1)) - cutoffs[k];
+    for (long block = begin; block < end; block += G_BLOCK) {
+        unsigned int nBlock = 0;
+        for (long n = block; n < end && n < block + G_BLOCK; n++) {
+            rots[nBlock] = rotOuter * phases[walker->zv[0] - rows->lower[0]];
+            zArguments[nBlock] = walker->r2 * argScale;
+            nBlock++;
+            if (latticeWalkerNext(walker)) {
+                rotOuter = phaseOuter(dim, walker->zv, rows, phases, offsets);
+            }
         }
-        matrix_intVector(dim, m, zv, lv);
-        double complex rot = cexp(-2 * M_PI * I * dot(dim, lv, y));
-        for (int i = 0; i < dim; i++) {
-            lv[i] = lv[i] - x[i];
+        crandall_gBlock(nu, nBlock, zArguments, zArgBound, gamma, gTable, gs);
+        for (unsigned int j = 0; j < nBlock; j++) {
+            // summing using Kahan's method
+            auxy = rots[j] * gs[j] - epsilon;
+            auxt = sum + auxy;
+            epsilon = (auxt - sum) - auxy;
+            sum = auxt;
         }
-        // summing using Kahan's method
-        auxy = rot * crandall_g(dim, nu, lv, 1. / lambda, zArgBound) - epsilon;
-        auxt = sum + auxy;
-        epsilon = (auxt - sum) - auxy;
-        sum = auxt;
     }
+    latticeWalkerFree(walker);
     return sum;
 }
 
@@ -92,58 +201,461 @@ double complex sum_real(double nu, unsigned int dim, double lambda, const double
  * function.
  * @param[in] x: projection of x vector to elementary lattice cell.
  * @param[in] y: projection of y vector to elementary lattice cell.
- * @param[in] cutoffs: how many summands in each direction are considered.
+ * @param[in] rows: reciprocal lattice points k + y within the cutoff radius,
+ * enumerated with latticeRowsCreate for the shift y.
  * @param[in] zArgBound: global bound on when to use the asymptotic expansion in
  * the incomplete gamma evaluation.
+ * @param[in] gamma: constants of the upper incomplete gamma function in G.
+ * @param[in] gTable: table of G from crandall_gTableCreate, or NULL.
+ * @param[in] begin: first flat index of the rows that is summed.
+ * @param[in] end: flat index after the last index that is summed.
  * @return helper function for the second sum in crandalls formula. Calculates
  * sum_{k in m_invt whole_numbers ** dim without zero} G_{dim - nu}(lambda * (k + y))
  * X exp(-2 * PI * I * x * (k + y))
  */
 double complex sum_fourier(double nu, unsigned int dim, double lambda,
                            const double *m_invt, const double *x, const double *y,
-                           const int cutoffs[], double zArgBound) {
-    int zv[dim];    // counting vector in Z^dim
-    double lv[dim]; // lattice vector
-    // cuboid cutoffs
-    long totalSummands = 1;
-    long totalCutoffs[dim + 1];
-    for (int k = 0; k < dim; k++) {
-        totalCutoffs[k] = totalSummands;
-        totalSummands *= 2 * cutoffs[k] + 1;
-    };
-    long zeroIndex = (totalSummands - 1) / 2;
+                           const struct latticeRows *rows, double zArgBound,
+                           const struct egfContext *gamma,
+                           const struct crandallGTable *gTable, long begin,
+                           long end) {
+    long zeroIndex = rows->zeroIndex;
     double complex sum = 0.0;
     double complex epsilon = 0.0;
     double complex auxt;
     double complex auxy;
+    double complex rots[G_BLOCK];
+    double zArguments[G_BLOCK];
+    double gs[G_BLOCK];
+    double complex phases[phaseTableSize(rows)];
+    long offsets[dim];
+    phaseTable(dim, m_invt, x, rows, phases, offsets);
+    double complex rotY = cexp(-2 * M_PI * I * dot(dim, y, x));
+    double argScale = M_PI * lambda * lambda;
+    struct latticeWalker *walker = latticeWalkerCreate(
+        dim, m_invt, y, rows, LATTICE_EXACT_ARG / argScale, begin);
+    if (walker == NULL) {
+        return NAN;
+    }
+    double complex rotOuter =
+        rotY * phaseOuter(dim, walker->zv, rows, phases, offsets);
     // second sum (in fourier space)
-    for (long n = 0; n < zeroIndex; n++) {
-        for (int k = 0; k < dim; k++) {
-            zv[k] =
-                (((int)(n / totalCutoffs[k])) % (2 * cutoffs[k] + 1)) - cutoffs[k];
+    for (long block = begin; block < end; block += G_BLOCK) {
+        unsigned int nBlock = 0;
+        for (long n = block; n < end && n < block + G_BLOCK; n++) {
+            // skips zero
+            if (n != zeroIndex) {
+                rots[nBlock] = rotOuter * phases[walker->zv[0] - rows->lower[0]];
+                zArguments[nBlock] = walker->r2 * argScale;
+                nBlock++;
+            }
+            if (latticeWalkerNext(walker)) {
+                rotOuter = rotY * phaseOuter(dim, walker->zv, rows, phases, offsets);
+            }
         }
-        matrix_intVector(dim, m_invt, zv, lv);
-        for (int i = 0; i < dim; i++) {
-            lv[i] = lv[i] + y[i];
+        crandall_gBlock(dim - nu, nBlock, zArguments, zArgBound, gamma, gTable,
+                        gs);
+        for (unsigned int j = 0; j < nBlock; j++) {
+            auxy = rots[j] * gs[j] - epsilon;
+            auxt = sum + auxy;
+            epsilon = (auxt - sum) - auxy;
+            sum = auxt;
         }
-        double complex rot = cexp(-2 * M_PI * I * dot(dim, lv, x));
-        auxy = rot * crandall_g(dim, dim - nu, lv, lambda, zArgBound) - epsilon;
-        auxt = sum + auxy;
-        epsilon = (auxt - sum) - auxy;
-        sum = auxt;
     }
-    // skips zero
-    for (long n = zeroIndex + 1; n < totalSummands; n++) {
-        for (int k = 0; k < dim; k++) {
-            zv[k] =
-                (((int)(n / totalCutoffs[k])) % (2 * cutoffs[k] + 1)) - cutoffs[k];
-        }
-        matrix_intVector(dim, m_invt, zv, lv);
-        for (int i = 0; i < dim; i++) {
-            lv[i] = lv[i] + y[i];
+    latticeWalkerFree(walker);
+    return sum;
+}
+
+/**
+ * @brief estimates the number of lattice points within a ball for a lattice of
+ * unit volume by the volume of the ball.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] radius: radius of the ball.
+ * @return pi^(dim / 2) / Gamma(dim / 2 + 1) * radius^dim
+ */
+double ballVolume(unsigned int dim, double radius) {
+    return pow(M_PI, dim / 2.) / tgamma(dim / 2. + 1) * pow(radius, dim);
+}
+
+/**
+ * @brief how a sum over rows halved with latticeRowsHalve is unfolded to the
+ * sum over all rows.
+ */
+struct sumHalf {
+    bool halved; //!< true if the rows were halved.
+    bool self;   //!< true if the point v = 0, its own partner, was summed.
+    bool zero;   //!< true if the summand for zv = 0 has to be subtracted.
+};
+
+/**
+ * @brief halves the rows of one of the sums in Crandall's formula if the points
+ * v = m zv + shift are symmetric under inversion. The summands for v and -v then
+ * share the value of G, and their phases are complex conjugates up to a common
+ * factor, such that G is only evaluated for one point of every pair.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in, out] rows: points of the sum, halved if they are symmetric.
+ * @param[in] skipZero: true if the sum skips the summand for zv = 0.
+ * @param[out] center2: twice the counting vector of the point v = 0.
+ * @return data to unfold the sum over the halved rows with sum_unfold.
+ */
+struct sumHalf sum_halve(unsigned int dim, const double *m, const double *shift,
+                         struct latticeRows *rows, bool skipZero, int *center2) {
+    struct sumHalf half = {false, false, false};
+    if (!latticeSymmetric(dim, m, shift, center2)) {
+        return half;
+    }
+    bool zeroEnumerated = rows->zeroIndex >= 0;
+    long selfIndex = latticeRowsHalve(rows, center2);
+    half.halved = true;
+    if (skipZero && selfIndex >= 0 && selfIndex == rows->zeroIndex) {
+        // zv = 0 is its own partner and stays skipped
+        return half;
+    }
+    half.self = selfIndex >= 0;
+    if (skipZero) {
+        // the partner of zv = 0 is summed, so zv = 0 is summed as well and
+        // subtracted after unfolding
+        half.zero = zeroEnumerated;
+        rows->zeroIndex = -1;
+    }
+    return half;
+}
+
+/**
+ * @brief unfolds a sum over rows halved with sum_halve. A summand
+ * phase * G(v) * exp(-2 * PI * I * v * w) and the summand of -v add up to
+ * phase * 2 * G(v) * cos(2 * PI * v * w), so only the real part of the sum
+ * divided by the common phase is needed.
+ * @param[in] half: result of sum_halve.
+ * @param[in] sum: sum over the halved rows.
+ * @param[in] phase: common phase of all summands, of absolute value 1.
+ * @param[in] selfTerm: summand for the point v = 0, which was summed once.
+ * @param[in] zeroTerm: summand for zv = 0.
+ * @return sum over all rows.
+ */
+double complex sum_unfold(struct sumHalf half, double complex sum,
+                          double complex phase, double complex selfTerm,
+                          double complex zeroTerm) {
+    if (!half.halved) {
+        return sum;
+    }
+    double real = 2 * creal(conj(phase) * sum);
+    if (half.self) {
+        real -= creal(conj(phase) * selfTerm);
+    }
+    sum = phase * real;
+    if (half.zero) {
+        sum -= zeroTerm;
+    }
+    return sum;
+}
+
+/**
+ * @brief calculates a single summand of one of the sums in Crandall's formula.
+ * @param[in] nu: exponent of G.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase of the summand.
+ * @param[in] prefactor: prefactor of the argument of G.
+ * @param[in] zArgBound: bound on when to use the asymptotic expansion.
+ * @param[in] zv: counting vector of the summand.
+ * @return G_{nu}(prefactor * (m zv + shift)) * exp(-2 * PI * I * (m zv) * w)
+ */
+double complex sum_term(double nu, unsigned int dim, const double *m,
+                        const double *shift, const double *w, double prefactor,
+                        double zArgBound, const int *zv) {
+    double z[dim];
+    double v[dim];
+    for (int i = 0; i < dim; i++) {
+        z[i] = 0;
+        for (int j = 0; j < dim; j++) {
+            z[i] += m[i * dim + j] * zv[j];
         }
-        double complex rot = cexp(-2 * M_PI * I * dot(dim, lv, x));
-        auxy = rot * crandall_g(dim, dim - nu, lv, lambda, zArgBound) - epsilon;
+        v[i] = z[i] + shift[i];
+    }
+    return crandall_g(dim, nu, v, prefactor, zArgBound) *
+           cexp(-2 * M_PI * I * dot(dim, z, w));
+}
+
+/**
+ * @brief calculates the summand of the first sum in Crandall's formula for the
+ * point v = 0 of halved rows.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: projection of x vector to elementary lattice cell.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @param[in] half: result of sum_halve for the first sum.
+ * @param[in] center2: twice the counting vector of the point v = 0.
+ * @return summand for zv = center2 / 2, 0 if it was not summed.
+ */
+double complex sum_realSelf(const struct epsteinZetaPlan *plan, const double *x,
+                            const double *y, struct sumHalf half,
+                            const int *center2) {
+    unsigned int dim = plan->dim;
+    if (!half.self) {
+        return 0;
+    }
+    int zv[dim];
+    double shift[dim];
+    for (int i = 0; i < dim; i++) {
+        zv[i] = center2[i] / 2;
+        shift[i] = -x[i];
+    }
+    return sum_term(plan->nu, dim, plan->m_real, shift, y, 1. / plan->lambda,
+                    plan->zArgBound, zv);
+}
+
+/**
+ * @brief calculates the summand of the second sum in Crandall's formula for the
+ * point v = 0 of halved rows.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector in the phase of the second sum.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @param[in] half: result of sum_halve for the second sum.
+ * @param[in] center2: twice the counting vector of the point v = 0.
+ * @return summand for zv = center2 / 2, 0 if it was not summed.
+ */
+double complex sum_fourierSelf(const struct epsteinZetaPlan *plan, const double *x,
+                               const double *y, struct sumHalf half,
+                               const int *center2) {
+    unsigned int dim = plan->dim;
+    if (!half.self) {
+        return 0;
+    }
+    int zv[dim];
+    for (int i = 0; i < dim; i++) {
+        zv[i] = center2[i] / 2;
+    }
+    return cexp(-2 * M_PI * I * dot(dim, y, x)) *
+           sum_term(dim - plan->nu, dim, plan->m_fourier, y, x, plan->lambda,
+                    plan->zArgBound, zv);
+}
+
+/**
+ * @brief calculates the summand for k = 0 of the second sum in Crandall's
+ * formula, which is summed over halved rows if its partner is.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector in the phase of the second sum.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @param[in] half: result of sum_halve for the second sum.
+ * @return G_{dim - nu}(lambda * y) * exp(-2 * PI * I * x * y), 0 if it was not
+ * summed.
+ */
+double complex sum_fourierZero(const struct epsteinZetaPlan *plan, const double *x,
+                               const double *y, struct sumHalf half) {
+    if (!half.zero) {
+        return 0;
+    }
+    return crandall_g(plan->dim, plan->dim - plan->nu, y, plan->lambda,
+                      plan->zArgBound) *
+           cexp(-2 * M_PI * I * dot(plan->dim, y, x));
+}
+
+/**
+ * @brief calculates the first sum in Crandall's formula over all lattice points
+ * within the cutoff radius of a plan.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: projection of x vector to elementary lattice cell.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @return first sum, NAN if memory allocation fails.
+ */
+double complex sum_realPlan(const struct epsteinZetaPlan *plan, const double *x,
+                            const double *y) {
+    unsigned int dim = plan->dim;
+    double shift[dim];
+    for (int i = 0; i < dim; i++) {
+        shift[i] = -x[i];
+    }
+    struct latticeRows *rows =
+        latticeRowsCreate(dim, plan->m_real, shift, plan->radiusReal);
+    if (rows == NULL) {
+        return NAN;
+    }
+    int center2[dim];
+    struct sumHalf half =
+        sum_halve(dim, plan->m_real, shift, rows, false, center2);
+    double complex sum =
+        sum_real(plan->nu, dim, plan->lambda, plan->m_real, x, y, rows,
+                 plan->zArgBound, &plan->gammaReal, plan->gTableReal, 0,
+                 rows->nPoints);
+    latticeRowsFree(rows);
+    return sum_unfold(half, sum, cexp(-2 * M_PI * I * dot(dim, x, y)),
+                      sum_realSelf(plan, x, y, half, center2), 0);
+}
+
+/**
+ * @brief calculates the second sum in Crandall's formula over all reciprocal
+ * lattice points within the cutoff radius of a plan.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector in the phase of the second sum.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @return second sum without the summand for k = 0, NAN if memory allocation
+ * fails.
+ */
+double complex sum_fourierPlan(const struct epsteinZetaPlan *plan, const double *x,
+                               const double *y) {
+    struct latticeRows *rows =
+        latticeRowsCreate(plan->dim, plan->m_fourier, y, plan->radiusFourier);
+    if (rows == NULL) {
+        return NAN;
+    }
+    int center2[plan->dim];
+    struct sumHalf half =
+        sum_halve(plan->dim, plan->m_fourier, y, rows, true, center2);
+    double complex sum =
+        sum_fourier(plan->nu, plan->dim, plan->lambda, plan->m_fourier, x, y, rows,
+                    plan->zArgBound, &plan->gammaFourier, plan->gTableFourier,
+                    0, rows->nPoints);
+    latticeRowsFree(rows);
+    return sum_unfold(half, sum, 1, sum_fourierSelf(plan, x, y, half, center2),
+                      sum_fourierZero(plan, x, y, half));
+}
+
+/**
+ * @brief arguments and results for one part of both sums in Crandall's formula.
+ */
+struct sumsPart {
+    const struct epsteinZetaPlan *plan;    //!< precomputed lattice data.
+    const double *x;                       //!< x vector in the first sum.
+    const double *y;                       //!< y vector in both sums.
+    const double *xf;                      //!< x vector in the second sum.
+    const struct latticeRows *rowsReal;    //!< summands of the first sum.
+    const struct latticeRows *rowsFourier; //!< summands of the second sum.
+    long realBegin;                        //!< first index of the first sum.
+    long realEnd;                          //!< end index of the first sum.
+    long fourierBegin;                     //!< first index of the second sum.
+    long fourierEnd;                       //!< end index of the second sum.
+    double complex s1;                     //!< partial first sum.
+    double complex s2;                     //!< partial second sum.
+};
+
+/**
+ * @brief calculates one part of both sums in Crandall's formula.
+ * @param[in, out] arg: pointer to a struct sumsPart.
+ * @return NULL
+ */
+void *sumsPartRun(void *arg) {
+    struct sumsPart *part = arg;
+    const struct epsteinZetaPlan *plan = part->plan;
+    part->s1 = sum_real(plan->nu, plan->dim, plan->lambda, plan->m_real, part->x,
+                        part->y, part->rowsReal, plan->zArgBound,
+                        &plan->gammaReal, plan->gTableReal, part->realBegin,
+                        part->realEnd);
+    part->s2 = sum_fourier(plan->nu, plan->dim, plan->lambda, plan->m_fourier,
+                           part->xf, part->y, part->rowsFourier,
+                           plan->zArgBound, &plan->gammaFourier,
+                           plan->gTableFourier, part->fourierBegin,
+                           part->fourierEnd);
+    return NULL;
+}
+
+/**
+ * @brief calculates both sums in Crandall's formula. If more than one thread
+ * is configured, the flat index ranges of both sums are split evenly, and every
+ * thread sums one part of each sum with its own Kahan accumulator. Block
+ * diagonal lattices for which the plan chose it are summed with theta_sum
+ * instead. Sets both sums to NAN if memory allocation fails.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: projection of x vector to elementary lattice cell.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @param[in] xf: x vector in the phase of the second sum.
+ * @param[out] s1: first sum.
+ * @param[out] s2: second sum without the summand for k = 0.
+ */
+void sum_both(const struct epsteinZetaPlan *plan, const double *x, const double *y,
+              const double *xf, double complex *s1, double complex *s2) {
+    unsigned int dim = plan->dim;
+    double shift[dim];
+    for (int i = 0; i < dim; i++) {
+        shift[i] = -x[i];
+    }
+    if (plan->nBlocks > 1) {
+        double lambda = plan->lambda;
+        *s1 = theta_sum(plan->nu, dim, plan->m_real, shift, y,
+                        M_PI / (lambda * lambda), plan->radiusReal, false,
+                        plan->zArgBound, plan->nBlocks, plan->axisBlock);
+        *s2 = cexp(-2 * M_PI * I * dot(dim, y, xf)) *
+              theta_sum(dim - plan->nu, dim, plan->m_fourier, y, xf,
+                        M_PI * lambda * lambda, plan->radiusFourier, true,
+                        plan->zArgBound, plan->nBlocks, plan->axisBlock);
+        return;
+    }
+    struct latticeRows *rowsReal =
+        latticeRowsCreate(dim, plan->m_real, shift, plan->radiusReal);
+    struct latticeRows *rowsFourier =
+        latticeRowsCreate(dim, plan->m_fourier, y, plan->radiusFourier);
+    if (rowsReal == NULL || rowsFourier == NULL) {
+        latticeRowsFree(rowsReal);
+        latticeRowsFree(rowsFourier);
+        *s1 = *s2 = NAN;
+        return;
+    }
+    int center2Real[dim];
+    int center2Fourier[dim];
+    struct sumHalf halfReal =
+        sum_halve(dim, plan->m_real, shift, rowsReal, false, center2Real);
+    struct sumHalf halfFourier =
+        sum_halve(dim, plan->m_fourier, y, rowsFourier, true, center2Fourier);
+    long nReal = rowsReal->nPoints;
+    long nFourier = rowsFourier->nPoints;
+    long nThreads = threadsGetNum();
+    if ((nReal + nFourier) / MIN_SUMMANDS_THREAD < nThreads) {
+        nThreads = (nReal + nFourier) / MIN_SUMMANDS_THREAD;
+    }
+    if (nThreads < 1) {
+        nThreads = 1;
+    }
+    struct sumsPart parts[nThreads];
+    for (long t = 0; t < nThreads; t++) {
+        parts[t] = (struct sumsPart){plan,
+                                     x,
+                                     y,
+                                     xf,
+                                     rowsReal,
+                                     rowsFourier,
+                                     t * nReal / nThreads,
+                                     (t + 1) * nReal / nThreads,
+                                     t * nFourier / nThreads,
+                                     (t + 1) * nFourier / nThreads,
+                                     0,
+                                     0};
+    }
+    threadsRun(nThreads, sumsPartRun, parts, sizeof(struct sumsPart));
+    *s1 = parts[0].s1;
+    *s2 = parts[0].s2;
+    for (long t = 1; t < nThreads; t++) {
+        *s1 += parts[t].s1;
+        *s2 += parts[t].s2;
+    }
+    *s1 = sum_unfold(halfReal, *s1, cexp(-2 * M_PI * I * dot(dim, x, y)),
+                     sum_realSelf(plan, x, y, halfReal, center2Real), 0);
+    *s2 = sum_unfold(halfFourier, *s2, 1,
+                     sum_fourierSelf(plan, xf, y, halfFourier, center2Fourier),
+                     sum_fourierZero(plan, xf, y, halfFourier));
+    latticeRowsFree(rowsReal);
+    latticeRowsFree(rowsFourier);
+}
+
+/**
+ * @brief calculates one of the sums in Crandall's formula from precomputed
+ * values of G.
+ * @param[in] table: lattice points and the values of G at these points.
+ * @param[in] w: vector in the phase of the summands.
+ * @return sum_{j} coeffs[j] * exp(-2 * PI * I * points[j] * w)
+ */
+double complex sum_table(const struct epsteinZetaSumTable *table, const double *w) {
+    unsigned int dim = table->dim;
+    double complex sum = 0.0;
+    double complex epsilon = 0.0;
+    double complex auxt;
+    double complex auxy;
+    for (long n = 0; n < table->n; n++) {
+        double complex rot =
+            cexp(-2 * M_PI * I * dot(dim, table->points + n * dim, w));
+        // summing using Kahan's method
+        auxy = rot * table->coeffs[n] - epsilon;
         auxt = sum + auxy;
         epsilon = (auxt - sum) - auxy;
         sum = auxt;
@@ -158,7 +670,7 @@ double complex sum_fourier(double nu, unsigned int dim, double lambda,
  * @param[in] m_invt: inverse of m.
  * @param[in] v: vector for which the projection to the elementary lattice cell
  * is needet.
- * @return projection of v to the elementary lattice cell.
+ * @return projection of v to the elementary lattice cell, has to be freed.
  */
 double *vectorProj(unsigned int dim, const double *m, const double *m_invt,
                    const double *v) {
@@ -195,129 +707,596 @@ double *vectorProj(unsigned int dim, const double *m, const double *m_invt,
 }
 
 /**
- * @brief calculates the (regularized) Epstein Zeta function.
+ * @brief chooses the relative weight of the sums in Crandall's formula, such
+ * that the estimated number of summands in both sums is minimal.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m_real: reduced basis of the lattice of unit volume.
+ * @param[in] m_fourier: reduced basis of the reciprocal lattice.
+ * @param[in] cutoffReal: cutoff radius of the first sum for lambda = 1.
+ * @param[in] cutoffFourier: cutoff radius of the second sum for lambda = 1.
+ * @return lambda, a power of two with exponent in steps of 1 / LAMBDA_STEPS.
+ */
+double optimalLambda(unsigned int dim, const double *m_real,
+                     const double *m_fourier, double cutoffReal,
+                     double cutoffFourier) {
+    double lambda = 1;
+    double countMin = INFINITY;
+    for (int k = -LAMBDA_OCTAVES * LAMBDA_STEPS; k <= LAMBDA_OCTAVES * LAMBDA_STEPS;
+         k++) {
+        double l = exp2((double)k / LAMBDA_STEPS);
+        double count = latticeCountEstimate(dim, m_real, cutoffReal * l) +
+                       latticeCountEstimate(dim, m_fourier, cutoffFourier / l);
+        if (count < countMin) {
+            countMin = count;
+            lambda = l;
+        }
+    }
+    return lambda;
+}
+
+/**
+ * @brief precomputes everything in Crandall's formula that only depends on the
+ * exponent nu, the lattice matrix m and the weight lambda.
  * @param[in] nu: exponent for the Epstein zeta function.
  * @param[in] dim: dimension of the input vectors.
  * @param[in] m: matrix that transforms the lattice in the Epstein Zeta
  * function.
- * @param[in] x: x vector of the Epstein Zeta function.
- * @param[in] y: y vector of the Epstein Zeta function.
- * @param[in] lambda: relative weight of the sums in Crandall's formula.
- * @param[in] reg: 0 for no regularization, > 0 for the regularization.
- * @return function value of the regularized Epstein zeta.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums, 0
+ * for full double precision.
+ * @return plan for repeated evaluations, NULL if memory allocation fails. Has to
+ * be freed with epsteinZetaPlanFree.
  */
-double complex epsteinZetaInternal(double nu, unsigned int dim, // NOLINT
-                                   const double *m, const double *x, const double *y,
-                                   double lambda, int reg) {
-    // 1. Transform: Compute determinant and fourier transformed matrix, scale
-    // both of them
-    double m_fourier[dim * dim];
+struct epsteinZetaPlan *epsteinZetaPlanInternal(double nu, unsigned int dim,
+                                                const double *m, double lambda,
+                                                double tol) {
+    // store struct and all arrays in one block of memory
+    struct epsteinZetaPlan *plan =
+        malloc(sizeof(struct epsteinZetaPlan) + 3 * dim * dim * sizeof(double) +
+               dim * sizeof(int));
+    if (plan == NULL) {
+        return NULL;
+    }
+    plan->nu = nu;
+    plan->dim = dim;
+    plan->gTableReal = NULL;
+    plan->gTableFourier = NULL;
+    egf_contextInit(nu / 2, &plan->gammaReal);
+    egf_contextInit((dim - nu) / 2, &plan->gammaFourier);
+    plan->m_real = (double *)(plan + 1);
+    plan->m_realInvt = plan->m_real + dim * dim;
+    plan->m_fourier = plan->m_realInvt + dim * dim;
+    plan->axisBlock = (int *)(plan->m_fourier + dim * dim);
+    double *m_fourier = plan->m_fourier;
+    double *m_real = plan->m_real;
+    double *m_realInvt = plan->m_realInvt;
+    // 1. Transform: reduce the basis, as the sums only depend on the lattice.
+    // Compute determinant and fourier transformed matrix, scale both of them
+    double u[dim * dim];
+    latticeReduce(dim, m, u);
     double m_copy[dim * dim];
-    double m_real[dim * dim];
-    double x_t1[dim];
-    double y_t1[dim];
     int p[dim];
-    bool isDiagonal = 1;
     for (int i = 0; i < dim; i++) {
         for (int j = 0; j < dim; j++) {
-            m_copy[dim * i + j] = m[dim * i + j];
-            m_real[dim * i + j] = m[dim * i + j];
-            isDiagonal = isDiagonal && ((i == j) || (m[dim * i + j] == 0));
+            m_real[dim * i + j] = 0;
+            for (int k = 0; k < dim; k++) {
+                m_real[dim * i + j] += m[dim * i + k] * u[dim * k + j];
+            }
+            m_copy[dim * i + j] = m_real[dim * i + j];
         }
     }
-    invert(dim, m_copy, p, m_fourier);
+    invert(dim, m_copy, p, m_realInvt);
     double vol = 1;
     for (int k = 0; k < dim; k++) {
         vol *= m_copy[dim * k + k];
     }
-    transpose(dim, m_fourier);
+    transpose(dim, m_realInvt);
     vol = fabs(vol);
     double ms = pow(vol, -1. / dim);
     for (int i = 0; i < dim * dim; i++) {
         m_real[i] *= ms;
-        m_fourier[i] /= ms;
+        m_realInvt[i] /= ms;
     }
+    plan->ms = ms;
+    // the dual of a reduced basis need not be reduced, so the basis of the
+    // reciprocal lattice is reduced on its own
+    latticeReduce(dim, m_realInvt, u);
     for (int i = 0; i < dim; i++) {
-        x_t1[i] = x[i] * ms;
-        y_t1[i] = y[i] / ms;
+        for (int j = 0; j < dim; j++) {
+            m_fourier[dim * i + j] = 0;
+            for (int k = 0; k < dim; k++) {
+                m_fourier[dim * i + j] += m_realInvt[dim * i + k] * u[dim * k + j];
+            }
+        }
     }
-    // 2. transform: get x and y in their respective elementary cells
-    double *x_t2 = vectorProj(dim, m_real, m_fourier, x_t1);
-    double *y_t2 = vectorProj(dim, m_fourier, m_real, y_t1);
-    // set cutoffs
-    int cutoffsReal[dim];
-    int cutoffsFourier[dim];
-    double cutoff_id = G_BOUND + 0.5;
-    if (isDiagonal) {
-        // Chose absolute diag. entries for cutoff
-        for (int k = 0; k < dim; k++) {
-            cutoffsReal[k] = floor(cutoff_id / fabs(m_real[dim * k + k]));
-            cutoffsFourier[k] = floor(cutoff_id * fabs(m_real[dim * k + k]));
+    // cutoff radii of the sums, beyond which the summands are negligible
+    double cutoffReal = G_BOUND + 0.5;
+    double cutoffFourier = G_BOUND + 0.5;
+    plan->zArgBound = assignzArgBound(nu);
+    if (tol > 0) {
+        // the tails of both sums each get a quarter of the tolerance, 0.5
+        // accounts for the shift. The error of the asymptotic expansion of G is
+        // only estimated by its first neglected term and gets a smaller share.
+        cutoffReal = crandall_gCutoff(dim, nu, tol / 4) + 0.5;
+        cutoffFourier = crandall_gCutoff(dim, dim - nu, tol / 4) + 0.5;
+        double zArgBoundTol = fmax(crandall_zArgBoundTol(dim, nu, tol / 64),
+                                   crandall_zArgBoundTol(dim, dim - nu, tol / 64));
+        // the bound for full precision is tuned for nu and used in both sums
+        plan->zArgBound = fmin(plan->zArgBound, zArgBoundTol);
+    }
+    if (!(lambda > 0)) {
+        lambda = optimalLambda(dim, m_real, m_fourier, cutoffReal, cutoffFourier);
+    }
+    plan->lambda = lambda;
+    plan->radiusReal = cutoffReal * lambda;
+    plan->radiusFourier = cutoffFourier / lambda;
+    plan->nBlocks = theta_blocks(dim, m_real, m_fourier, plan->axisBlock);
+    if (!theta_faster(dim, m_real, plan->radiusReal, plan->radiusFourier,
+                      plan->nBlocks, plan->axisBlock)) {
+        plan->nBlocks = 1;
+    }
+    return plan;
+}
+
+/**
+ * @brief frees a plan created by epsteinZetaPlanInternal.
+ * @param[in, out] plan: plan to free, may be NULL.
+ */
+void epsteinZetaPlanFree(struct epsteinZetaPlan *plan) {
+    if (plan != NULL) {
+        free(plan->gTableReal);
+        free(plan->gTableFourier);
+    }
+    free(plan);
+}
+
+/**
+ * @brief tabulates G for both sums of a plan up to the smaller of the bound for
+ * the asymptotic expansion and the largest argument within the cutoff radius.
+ * Exponents for which the tables do not reach full double precision keep the
+ * direct evaluation.
+ * @param[in, out] plan: plan created by epsteinZetaPlanInternal.
+ */
+void epsteinZetaPlanTabulate(struct epsteinZetaPlan *plan) {
+    double cutoffReal = plan->radiusReal / plan->lambda;
+    double cutoffFourier = plan->radiusFourier * plan->lambda;
+    free(plan->gTableReal);
+    free(plan->gTableFourier);
+    plan->gTableReal = crandall_gTableCreate(
+        plan->nu, fmin(plan->zArgBound, M_PI * cutoffReal * cutoffReal));
+    plan->gTableFourier =
+        crandall_gTableCreate(plan->dim - plan->nu,
+                              fmin(plan->zArgBound,
+                                   M_PI * cutoffFourier * cutoffFourier));
+}
+
+/**
+ * @brief allocates a table for the summands of one of the sums in Crandall's
+ * formula.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] n: number of summands.
+ * @return table with room for n summands, NULL if memory allocation fails.
+ */
+struct epsteinZetaSumTable *sumTableAlloc(unsigned int dim, long n) {
+    struct epsteinZetaSumTable *table = malloc(
+        sizeof(struct epsteinZetaSumTable) + n * (dim + 1) * sizeof(double));
+    if (table == NULL) {
+        return NULL;
+    }
+    table->n = n;
+    table->dim = dim;
+    table->points = (double *)(table + 1);
+    table->coeffs = table->points + n * dim;
+    return table;
+}
+
+/**
+ * @brief precomputes the summands of the first sum in Crandall's formula for a
+ * fixed x vector in the elementary lattice cell.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: projection of x vector to elementary lattice cell.
+ * @return lattice points z and G((z - x) / lambda), NULL if memory allocation
+ * fails.
+ */
+struct epsteinZetaSumTable *realTableProj(const struct epsteinZetaPlan *plan,
+                                          const double *x) {
+    unsigned int dim = plan->dim;
+    double shift[dim];
+    for (int i = 0; i < dim; i++) {
+        shift[i] = -x[i];
+    }
+    struct latticeRows *rows =
+        latticeRowsCreate(dim, plan->m_real, shift, plan->radiusReal);
+    struct epsteinZetaSumTable *table =
+        rows == NULL ? NULL : sumTableAlloc(dim, rows->nPoints);
+    struct latticeWalker *walker =
+        table == NULL
+            ? NULL
+            : latticeWalkerCreate(dim, plan->m_real, shift, rows, INFINITY, 0);
+    if (walker == NULL) {
+        latticeRowsFree(rows);
+        epsteinZetaSumTableFree(table);
+        return NULL;
+    }
+    for (long n = 0; n < table->n; n++, latticeWalkerNext(walker)) {
+        matrix_intVector(dim, plan->m_real, walker->zv, table->points + n * dim);
+        table->coeffs[n] = creal(crandall_g(dim, plan->nu, walker->v,
+                                            1. / plan->lambda, plan->zArgBound));
+    }
+    latticeWalkerFree(walker);
+    latticeRowsFree(rows);
+    return table;
+}
+
+/**
+ * @brief precomputes the summands of the first sum in Crandall's formula for a
+ * fixed x vector.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @return lattice points z and G((z - x) / lambda), NULL if memory allocation
+ * fails. Has to be freed with epsteinZetaSumTableFree.
+ */
+struct epsteinZetaSumTable *epsteinZetaRealTable(const struct epsteinZetaPlan *plan,
+                                                 const double *x) {
+    unsigned int dim = plan->dim;
+    double x_t1[dim];
+    for (int i = 0; i < dim; i++) {
+        x_t1[i] = x[i] * plan->ms;
+    }
+    double *x_t2 = vectorProj(dim, plan->m_real, plan->m_realInvt, x_t1);
+    struct epsteinZetaSumTable *table = realTableProj(plan, x_t2);
+    free(x_t2);
+    return table;
+}
+
+/**
+ * @brief precomputes the summands of the second sum in Crandall's formula for a
+ * fixed y vector.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return shifted reciprocal lattice points k + y and G(lambda * (k + y)) without
+ * the summand for k = 0, NULL if memory allocation fails. Has to be freed with
+ * epsteinZetaSumTableFree.
+ */
+struct epsteinZetaSumTable *
+epsteinZetaFourierTable(const struct epsteinZetaPlan *plan, const double *y) {
+    unsigned int dim = plan->dim;
+    double y_t1[dim];
+    for (int i = 0; i < dim; i++) {
+        y_t1[i] = y[i] / plan->ms;
+    }
+    double *y_t2 = vectorProj(dim, plan->m_realInvt, plan->m_real, y_t1);
+    struct latticeRows *rows =
+        latticeRowsCreate(dim, plan->m_fourier, y_t2, plan->radiusFourier);
+    struct epsteinZetaSumTable *table =
+        rows == NULL ? NULL : sumTableAlloc(dim, rows->nPoints);
+    struct latticeWalker *walker =
+        table == NULL
+            ? NULL
+            : latticeWalkerCreate(dim, plan->m_fourier, y_t2, rows, INFINITY, 0);
+    if (walker == NULL) {
+        latticeRowsFree(rows);
+        epsteinZetaSumTableFree(table);
+        free(y_t2);
+        return NULL;
+    }
+    long j = 0;
+    for (long n = 0; n < rows->nPoints; n++, latticeWalkerNext(walker)) {
+        // skips zero
+        if (n == rows->zeroIndex) {
+            continue;
         }
-    } else {
-        // choose cutoff depending on smallest and biggest abs eigenvalue
-        double ev_abs_max = inf_norm(dim, m_real);
-        double ev_abs_min_r = inf_norm(dim, m_fourier);
-        for (int k = 0; k < dim; k++) {
-            cutoffsReal[k] = floor(cutoff_id * ev_abs_min_r);
-            cutoffsFourier[k] = floor(cutoff_id * ev_abs_max);
+        double *point = table->points + j * dim;
+        for (int i = 0; i < dim; i++) {
+            point[i] = walker->v[i];
         }
+        table->coeffs[j] = creal(crandall_g(dim, dim - plan->nu, point,
+                                            plan->lambda, plan->zArgBound));
+        j++;
     }
+    table->n = j;
+    latticeWalkerFree(walker);
+    latticeRowsFree(rows);
+    free(y_t2);
+    return table;
+}
+
+/**
+ * @brief frees a table created by epsteinZetaRealTable or
+ * epsteinZetaFourierTable.
+ * @param[in, out] table: table to free, may be NULL.
+ */
+void epsteinZetaSumTableFree(struct epsteinZetaSumTable *table) { free(table); }
+
+/**
+ * @brief handles the special cases of non-positive even exponents and of the
+ * singularity at nu = dim, where the sums in Crandall's formula are not needed.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] x_t1: scaled x vector.
+ * @param[in] x_t2: projection of x_t1 to the elementary lattice cell.
+ * @param[in] y_t2: projection of the scaled y vector to the elementary cell of
+ * the reciprocal lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[out] res: function value of the (regularized) Epstein zeta for the
+ * lattice of unit volume, if a special case applies.
+ * @return true if a special case applies.
+ */
+bool specialCase(double nu, unsigned int dim, const double *x_t1,
+                 const double *x_t2, const double *y_t2, int reg,
+                 double complex *res) {
     // handle special case of non-positive integer values nu.
-    double complex res;
     if (nu < 1 && fabs(nu / 2. - nearbyint(nu / 2.)) < EPS) {
         if (dot(dim, x_t2, x_t2) == 0 && nu == 0) {
-            res = -1 * cexp(-2 * M_PI * I * dot(dim, x_t1, y_t2));
+            *res = -1 * cexp(-2 * M_PI * I * dot(dim, x_t1, y_t2));
         } else {
-            res = 0;
+            *res = 0;
         }
-    } else if (fabs(nu - dim) < EPS && equalsZero(dim, y_t2) && reg == 0) {
-        res = NAN;
+        return true;
+    }
+    if (fabs(nu - dim) < EPS && equalsZero(dim, y_t2) && reg == 0) {
+        *res = NAN;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief combines the two sums in Crandall's formula to the (regularized)
+ * Epstein zeta function.
+ * @param[in] plan: precomputed lattice data, only dim, lambda and the
+ * matrices are used.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] zArgBound: global bound on when to use the asymptotic expansion in
+ * the incomplete gamma evaluation.
+ * @param[in] x_t1: scaled x vector.
+ * @param[in] x_t2: projection of x_t1 to the elementary lattice cell.
+ * @param[in] y_t1: scaled y vector.
+ * @param[in] y_t2: projection of y_t1 to the elementary cell of the
+ * reciprocal lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[in] s1: first sum, evaluated at x_t2 and y_t2.
+ * @param[in] s2: second sum without the summand for k = 0, evaluated at y_t2 and
+ * with phases at x_t1 if reg > 0, else at x_t2.
+ * @return function value of the (regularized) Epstein zeta for the lattice of
+ * unit volume.
+ */
+double complex assembleCrandall(const struct epsteinZetaPlan *plan, double nu,
+                                double zArgBound, const double *x_t1,
+                                const double *x_t2, const double *y_t1,
+                                const double *y_t2, int reg, double complex s1,
+                                double complex s2) {
+    unsigned int dim = plan->dim;
+    double lambda = plan->lambda;
+    double complex nc;
+    double complex rot = 1;
+    double complex xfactor = 1;
+    double vx[dim];
+    for (int i = 0; i < dim; i++) {
+        vx[i] = x_t1[i] - x_t2[i];
+    }
+    xfactor = cexp(-2 * M_PI * I * dot(dim, vx, y_t1));
+    if (reg) {
+        // calculate regularized Epstein Zeta function values.
+        nc = crandall_gReg(dim, dim - nu, y_t1, lambda);
+        rot = cexp(2 * M_PI * I * dot(dim, x_t1, y_t1));
+        // correct wrong zero summand in regularized fourier sum.
+        if (!equals(dim, y_t1, y_t2)) {
+            s2 += crandall_g(dim, dim - nu, y_t2, lambda, zArgBound) *
+                      cexp(-2 * M_PI * I * dot(dim, x_t1, y_t2)) -
+                  crandall_g(dim, dim - nu, y_t1, lambda, zArgBound) *
+                      cexp(-2 * M_PI * I * dot(dim, x_t1, y_t1));
+        }
+        s2 = s2 * rot + nc;
+        s1 = s1 * rot * xfactor;
+        xfactor = 1;
     } else {
-        double zArgBound = assignzArgBound(nu);
+        // calculate non regularized Epstein Zeta function values.
+        nc = crandall_g(dim, dim - nu, y_t2, lambda, zArgBound) *
+             cexp(-2 * M_PI * I * dot(dim, x_t2, y_t2));
+        s2 += nc;
+    }
+    return xfactor * pow(lambda * lambda / M_PI, -nu / 2.) / tgamma(nu / 2.) *
+           (s1 + pow(lambda, dim) * s2);
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function from a plan.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[in] realTable: summands of the first sum precomputed with
+ * epsteinZetaRealTable for the same x, or NULL to sum directly.
+ * @param[in] fourierTable: summands of the second sum precomputed with
+ * epsteinZetaFourierTable for the same y, or NULL to sum directly.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaPlanExecuteTables(
+    const struct epsteinZetaPlan *plan, const double *x, const double *y, int reg,
+    const struct epsteinZetaSumTable *realTable,
+    const struct epsteinZetaSumTable *fourierTable) {
+    double nu = plan->nu;
+    unsigned int dim = plan->dim;
+    double ms = plan->ms;
+    double zArgBound = plan->zArgBound;
+    double x_t1[dim];
+    double y_t1[dim];
+    for (int i = 0; i < dim; i++) {
+        x_t1[i] = x[i] * ms;
+        y_t1[i] = y[i] / ms;
+    }
+    // 2. transform: get x and y in their respective elementary cells
+    double *x_t2 = vectorProj(dim, plan->m_real, plan->m_realInvt, x_t1);
+    double *y_t2 = vectorProj(dim, plan->m_realInvt, plan->m_real, y_t1);
+    double complex res;
+    if (!specialCase(nu, dim, x_t1, x_t2, y_t2, reg, &res)) {
         double complex s1;
         double complex s2;
-        double complex nc;
-        double complex rot = 1;
-        double complex xfactor = 1;
-        double vx[dim];
-        for (int i = 0; i < dim; i++) {
-            vx[i] = x_t1[i] - x_t2[i];
-        }
-        xfactor = cexp(-2 * M_PI * I * dot(dim, vx, y_t1));
-        if (reg) {
-            // calculate regularized Epstein Zeta function values.
-            nc = crandall_gReg(dim, dim - nu, y_t1, lambda);
-            rot = cexp(2 * M_PI * I * dot(dim, x_t1, y_t1));
-            s2 = sum_fourier(nu, dim, lambda, m_fourier, x_t1, y_t2, cutoffsFourier,
-                             zArgBound);
-            // correct wrong zero summand in regularized fourier sum.
-            if (!equals(dim, y_t1, y_t2)) {
-                s2 += crandall_g(dim, dim - nu, y_t2, lambda, zArgBound) *
-                          cexp(-2 * M_PI * I * dot(dim, x_t1, y_t2)) -
-                      crandall_g(dim, dim - nu, y_t1, lambda, zArgBound) *
-                          cexp(-2 * M_PI * I * dot(dim, x_t1, y_t1));
-            }
-            s2 = s2 * rot + nc;
-            s1 = sum_real(nu, dim, lambda, m_real, x_t2, y_t2, cutoffsReal,
-                          zArgBound) *
-                 rot * xfactor;
-            xfactor = 1;
+        const double *xf = reg ? x_t1 : x_t2;
+        if (realTable == NULL && fourierTable == NULL) {
+            sum_both(plan, x_t2, y_t2, xf, &s1, &s2);
         } else {
-            // calculate non regularized Epstein Zeta function values.
-            nc = crandall_g(dim, dim - nu, y_t2, lambda, zArgBound) *
-                 cexp(-2 * M_PI * I * dot(dim, x_t2, y_t2));
-            s1 = sum_real(nu, dim, lambda, m_real, x_t2, y_t2, cutoffsReal,
-                          zArgBound);
-            s2 = sum_fourier(nu, dim, lambda, m_fourier, x_t2, y_t2, cutoffsFourier,
-                             zArgBound) +
-                 nc;
+            s1 = realTable != NULL ? sum_table(realTable, y_t2)
+                                   : sum_realPlan(plan, x_t2, y_t2);
+            s2 = fourierTable != NULL ? sum_table(fourierTable, xf)
+                                      : sum_fourierPlan(plan, xf, y_t2);
         }
-        res = xfactor * pow(lambda * lambda / M_PI, -nu / 2.) / tgamma(nu / 2.) *
-              (s1 + pow(lambda, dim) * s2);
+        res = assembleCrandall(plan, nu, zArgBound, x_t1, x_t2, y_t1, y_t2, reg,
+                               s1, s2);
     }
     free(x_t2);
     free(y_t2);
     return pow(ms, nu) * res;
 }
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function from a plan.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaPlanExecuteInternal(const struct epsteinZetaPlan *plan,
+                                              const double *x, const double *y,
+                                              int reg) {
+    return epsteinZetaPlanExecuteTables(plan, x, y, reg, NULL, NULL);
+}
+
+/**
+ * @brief calculates one of the sums in Crandall's formula for the
+ * one-dimensional lattice of unit volume, whose points within the cutoff radius
+ * are an interval of integers.
+ * @param[in] nu: exponent of G.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: factor of the lattice points in the phase.
+ * @param[in] argScale: factor from the squared distances to the arguments of G.
+ * @param[in] radius: cutoff radius of the sum.
+ * @param[in] skipZero: true to skip the summand for n = 0.
+ * @param[in] zArgBound: global bound on when to use the asymptotic expansion in
+ * the incomplete gamma evaluation.
+ * @param[in] gamma: constants of the upper incomplete gamma function in G.
+ * @return sum_{|n + shift| <= radius} G(argScale (n + shift)^2) exp(-2 * PI * I
+ * * n * w)
+ */
+double complex sum_1d(double nu, double shift, double w, double argScale,
+                      double radius, bool skipZero, double zArgBound,
+                      const struct egfContext *gamma) {
+    double complex sum = 0.0;
+    double complex epsilon = 0.0;
+    double complex auxt;
+    double complex auxy;
+    double complex rots[G_BLOCK];
+    double zArguments[G_BLOCK];
+    double gs[G_BLOCK];
+    long lower = (long)ceil(-shift - radius);
+    long upper = (long)floor(-shift + radius);
+    double complex step = cexp(-2 * M_PI * I * w);
+    double complex rot = cexp(-2 * M_PI * I * lower * w);
+    for (long block = lower; block <= upper; block += G_BLOCK) {
+        unsigned int nBlock = 0;
+        for (long n = block; n <= upper && n < block + G_BLOCK; n++) {
+            if (n != 0 || !skipZero) {
+                rots[nBlock] = rot;
+                zArguments[nBlock] = argScale * (n + shift) * (n + shift);
+                nBlock++;
+            }
+            rot *= step;
+        }
+        crandall_gBlock(nu, nBlock, zArguments, zArgBound, gamma, NULL, gs);
+        for (unsigned int j = 0; j < nBlock; j++) {
+            // summing using Kahan's method
+            auxy = rots[j] * gs[j] - epsilon;
+            auxt = sum + auxy;
+            epsilon = (auxt - sum) - auxy;
+            sum = auxt;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function for a
+ * one-dimensional lattice. Both sums in Crandall's formula run over intervals of
+ * integers, such that no plan, basis reduction or enumeration is needed, and
+ * nothing is allocated.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] m: lattice constant, the lattice is m * whole_numbers.
+ * @param[in] x: x of the Epstein Zeta function.
+ * @param[in] y: y of the Epstein Zeta function.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZeta1d(double nu, double m, double x, double y,
+                             double lambda, int reg) {
+    double ms = 1 / fabs(m);
+    double x_t1 = x * ms;
+    double y_t1 = y / ms;
+    // projection to the elementary lattice cell as in vectorProj
+    double x_t2 = (x_t1 > -0.5 && x_t1 < 0.5) ? x_t1 : remainder(x_t1, 1);
+    double y_t2 = (y_t1 > -0.5 && y_t1 < 0.5) ? y_t1 : remainder(y_t1, 1);
+    double complex res;
+    if (specialCase(nu, 1, &x_t1, &x_t2, &y_t2, reg, &res)) {
+        return pow(ms, nu) * res;
+    }
+    // both cutoffs are equal, so optimalLambda chooses lambda = 1
+    if (!(lambda > 0)) {
+        lambda = 1;
+    }
+    double cutoff = G_BOUND + 0.5;
+    double zArgBound = assignzArgBound(nu);
+    struct egfContext gammaReal;
+    struct egfContext gammaFourier;
+    egf_contextInit(nu / 2, &gammaReal);
+    egf_contextInit((1 - nu) / 2, &gammaFourier);
+    double xf = reg ? x_t1 : x_t2;
+    double complex s1 = sum_1d(nu, -x_t2, y_t2, M_PI / (lambda * lambda),
+                               cutoff * lambda, false, zArgBound, &gammaReal);
+    double complex s2 = cexp(-2 * M_PI * I * y_t2 * xf) *
+                        sum_1d(1 - nu, y_t2, xf, M_PI * lambda * lambda,
+                               cutoff / lambda, true, zArgBound, &gammaFourier);
+    struct epsteinZetaPlan plan = {.nu = nu, .dim = 1, .lambda = lambda};
+    res = assembleCrandall(&plan, nu, zArgBound, &x_t1, &x_t2, &y_t1, &y_t2, reg,
+                           s1, s2);
+    return pow(ms, nu) * res;
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta
+ * function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums, 0
+ * for full double precision.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the regularized Epstein zeta, for one-dimensional
+ * lattices in full precision from epsteinZeta1d.
+ */
+double complex epsteinZetaInternal(double nu, unsigned int dim, const double *m,
+                                   const double *x, const double *y, double lambda,
+                                   double tol, int reg) {
+    if (dim == 1 && tol == 0) {
+        return epsteinZeta1d(nu, m[0], x[0], y[0], lambda, reg);
+    }
+    struct epsteinZetaPlan *plan = epsteinZetaPlanInternal(nu, dim, m, lambda, tol);
+    if (plan == NULL) {
+        return NAN;
+    }
+    double complex res = epsteinZetaPlanExecuteInternal(plan, x, y, reg);
+    epsteinZetaPlanFree(plan);
+    return res;
+}
+#undef MIN_SUMMANDS_THREAD
+#undef G_BLOCK
 #undef G_BOUND
+#undef LAMBDA_STEPS
+#undef LAMBDA_OCTAVES
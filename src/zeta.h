@@ -13,6 +13,252 @@
 #ifndef ZETA_H
 #define ZETA_H
 #include <complex.h>
+#include <stdbool.h>
+
+#include "gamma.h"
+#include "lattice.h"
+
+/**
+ * @brief precomputed data of Crandall's formula for a fixed exponent nu, lattice
+ * and weight lambda. Matrices are scaled to a lattice of unit volume, their
+ * columns are LLL-reduced bases of the lattice and of the reciprocal lattice.
+ */
+struct epsteinZetaPlan {
+    double nu;            //!< exponent for the Epstein zeta function.
+    unsigned int dim;     //!< dimension of the lattice.
+    double lambda;        //!< relative weight of the sums in Crandall's formula.
+    double ms;            //!< scaling factor of the lattice to unit volume.
+    double *m_real;       //!< scaled and reduced lattice matrix.
+    double *m_realInvt;   //!< inverse transposed of m_real.
+    double *m_fourier;    //!< scaled and reduced reciprocal lattice matrix.
+    double radiusReal;    //!< cutoff radius of the first sum.
+    double radiusFourier; //!< cutoff radius of the second sum.
+    double zArgBound;     //!< bound for the asymptotic expansion in G.
+    struct egfContext gammaReal;          //!< upper gamma for nu / 2.
+    struct egfContext gammaFourier;       //!< upper gamma for (dim - nu) / 2.
+    struct crandallGTable *gTableReal;    //!< table of G in the first sum.
+    struct crandallGTable *gTableFourier; //!< table of G in the second sum.
+    unsigned int nBlocks;                 //!< blocks for theta_sum, 1 if unused.
+    int *axisBlock;                       //!< block of each axis.
+};
+
+/**
+ * @brief summands of one of the sums in Crandall's formula with precomputed values
+ * of G, such that the sum equals sum_j coeffs[j] * exp(-2 * PI * I * points[j] * w)
+ * for the vector w in the phase.
+ */
+struct epsteinZetaSumTable {
+    long n;           //!< number of summands.
+    unsigned int dim; //!< dimension of the lattice.
+    double *points;   //!< n lattice points, stored one after another.
+    double *coeffs;   //!< values of G at the n lattice points.
+};
+
+/**
+ * @brief precomputes everything in Crandall's formula that only depends on the
+ * exponent nu, the lattice matrix m and the weight lambda.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it such that the estimated number of summands of both sums is minimal.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums, 0
+ * for full double precision.
+ * @return plan for repeated evaluations, NULL if memory allocation fails. Has to
+ * be freed with epsteinZetaPlanFree.
+ */
+struct epsteinZetaPlan *epsteinZetaPlanInternal(double nu, unsigned int dim,
+                                                const double *m, double lambda,
+                                                double tol);
+
+/**
+ * @brief tabulates G for both sums of a plan, such that the lattice sums
+ * interpolate G instead of evaluating the upper incomplete gamma function.
+ * Exponents for which the tables do not reach full double precision keep the
+ * direct evaluation.
+ * @param[in, out] plan: plan created by epsteinZetaPlanInternal.
+ */
+void epsteinZetaPlanTabulate(struct epsteinZetaPlan *plan);
+
+/**
+ * @brief frees a plan created by epsteinZetaPlanInternal.
+ * @param[in, out] plan: plan to free, may be NULL.
+ */
+void epsteinZetaPlanFree(struct epsteinZetaPlan *plan);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function from a plan.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZetaPlanExecuteInternal(const struct epsteinZetaPlan *plan,
+                                              const double *x, const double *y,
+                                              int reg);
+
+/**
+ * @brief precomputes the summands of the first sum in Crandall's formula for a
+ * fixed x vector.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @return lattice points z and G((z - x) / lambda), NULL if memory allocation
+ * fails. Has to be freed with epsteinZetaSumTableFree.
+ */
+struct epsteinZetaSumTable *epsteinZetaRealTable(const struct epsteinZetaPlan *plan,
+                                                 const double *x);
+
+/**
+ * @brief precomputes the summands of the second sum in Crandall's formula for a
+ * fixed y vector.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @return shifted reciprocal lattice points k + y and G(lambda * (k + y)) without
+ * the summand for k = 0, NULL if memory allocation fails. Has to be freed with
+ * epsteinZetaSumTableFree.
+ */
+struct epsteinZetaSumTable *
+epsteinZetaFourierTable(const struct epsteinZetaPlan *plan, const double *y);
+
+/**
+ * @brief frees a table created by epsteinZetaRealTable or
+ * epsteinZetaFourierTable.
+ * @param[in, out] table: table to free, may be NULL.
+ */
+void epsteinZetaSumTableFree(struct epsteinZetaSumTable *table);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function from a plan.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[in] realTable: summands of the first sum precomputed with
+ * epsteinZetaRealTable for the same x, or NULL to sum directly.
+ * @param[in] fourierTable: summands of the second sum precomputed with
+ * epsteinZetaFourierTable for the same y, or NULL to sum directly.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex
+epsteinZetaPlanExecuteTables(const struct epsteinZetaPlan *plan, const double *x,
+                             const double *y, int reg,
+                             const struct epsteinZetaSumTable *realTable,
+                             const struct epsteinZetaSumTable *fourierTable);
+
+/**
+ * @brief number of entries in the phase tables of enumerated lattice points.
+ * @param[in] rows: enumerated lattice points.
+ * @return sum_k (upper[k] - lower[k] + 1)
+ */
+long phaseTableSize(const struct latticeRows *rows);
+
+/**
+ * @brief precomputes the phases exp(-2 * PI * I * zv[k] * (m^T w)[k]) of
+ * enumerated summands along each axis.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] w: vector in the phase.
+ * @param[in] rows: enumerated lattice points.
+ * @param[out] phases: for each axis k, the phases for zv[k] = lower[k], ...,
+ * upper[k], stored one after another.
+ * @param[out] offsets: index of the first phase of each axis in phases.
+ */
+void phaseTable(unsigned int dim, const double *m, const double *w,
+                const struct latticeRows *rows, double complex *phases,
+                long *offsets);
+
+/**
+ * @brief multiplies the phases of all axes but the first from a phase table.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] zv: counting vector of the summand.
+ * @param[in] rows: enumerated lattice points.
+ * @param[in] phases: phase table computed by phaseTable.
+ * @param[in] offsets: offsets computed by phaseTable.
+ * @return prod_{k > 0} exp(-2 * PI * I * zv[k] * (m^T w)[k])
+ */
+double complex phaseOuter(unsigned int dim, const int *zv,
+                          const struct latticeRows *rows,
+                          const double complex *phases, const long *offsets);
+
+/**
+ * @brief estimates the number of lattice points within a ball for a lattice of
+ * unit volume by the volume of the ball.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] radius: radius of the ball.
+ * @return pi^(dim / 2) / Gamma(dim / 2 + 1) * radius^dim
+ */
+double ballVolume(unsigned int dim, double radius);
+
+/**
+ * @brief calculate projection of vector to elementary lattice cell.
+ * @param[in] dim: dimension of the input vectors
+ * @param[in] m: matrix that transforms the lattice in the function.
+ * @param[in] m_invt: inverse of m.
+ * @param[in] v: vector for which the projection to the elementary lattice cell
+ * is needet.
+ * @return projection of v to the elementary lattice cell, has to be freed.
+ */
+double *vectorProj(unsigned int dim, const double *m, const double *m_invt,
+                   const double *v);
+
+/**
+ * @brief handles the special cases of non-positive even exponents and of the
+ * singularity at nu = dim, where the sums in Crandall's formula are not needed.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] x_t1: scaled x vector.
+ * @param[in] x_t2: projection of x_t1 to the elementary lattice cell.
+ * @param[in] y_t2: projection of the scaled y vector to the elementary cell of
+ * the reciprocal lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[out] res: function value of the (regularized) Epstein zeta for the
+ * lattice of unit volume, if a special case applies.
+ * @return true if a special case applies.
+ */
+bool specialCase(double nu, unsigned int dim, const double *x_t1,
+                 const double *x_t2, const double *y_t2, int reg,
+                 double complex *res);
+
+/**
+ * @brief combines the two sums in Crandall's formula to the (regularized)
+ * Epstein zeta function.
+ * @param[in] plan: precomputed lattice data, only dim and lambda are used.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] zArgBound: global bound on when to use the asymptotic expansion in
+ * the incomplete gamma evaluation.
+ * @param[in] x_t1: scaled x vector.
+ * @param[in] x_t2: projection of x_t1 to the elementary lattice cell.
+ * @param[in] y_t1: scaled y vector.
+ * @param[in] y_t2: projection of y_t1 to the elementary cell of the
+ * reciprocal lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @param[in] s1: first sum, evaluated at x_t2 and y_t2.
+ * @param[in] s2: second sum without the summand for k = 0, evaluated at y_t2 and
+ * with phases at x_t1 if reg > 0, else at x_t2.
+ * @return function value of the (regularized) Epstein zeta for the lattice of
+ * unit volume.
+ */
+double complex assembleCrandall(const struct epsteinZetaPlan *plan, double nu,
+                                double zArgBound, const double *x_t1,
+                                const double *x_t2, const double *y_t1,
+                                const double *y_t2, int reg, double complex s1,
+                                double complex s2);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function for a
+ * one-dimensional lattice without a plan.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] m: lattice constant, the lattice is m * whole_numbers.
+ * @param[in] x: x of the Epstein Zeta function.
+ * @param[in] y: y of the Epstein Zeta function.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the regularized Epstein zeta.
+ */
+double complex epsteinZeta1d(double nu, double m, double x, double y,
+                             double lambda, int reg);
 
 /**
  * @brief calculates the (regularized) Epstein Zeta function.
@@ -21,11 +267,14 @@
  * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
  * @param[in] x: x vector of the Epstein Zeta function.
  * @param[in] y: y vector of the Epstein Zeta function.
- * @param[in] lambda: relative weight of the sums in Crandall's formula.
+ * @param[in] lambda: relative weight of the sums in Crandall's formula, 0 to
+ * choose it from the lattice.
+ * @param[in] tol: tolerance for the neglected summands of the lattice sums, 0
+ * for full double precision.
  * @param[in] regBool: 0 for no regularization, > 0 for the regularization.
  * @return function value of the regularized Epstein zeta.
  */
 double complex epsteinZetaInternal(double nu, unsigned int dim, const double *m,
                                    const double *x, const double *y, double lambda,
-                                   int regBool);
+                                   double tol, int regBool);
 #endif
@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file zetaf.c
+ * @brief Calculates the (regularized) Epstein zeta function with the lattice
+ * sums in single precision. The plan, the projections to the elementary cells
+ * and the assembly of Crandall's formula stay in double precision, as they are
+ * cheap and sensitive to rounding, the summands, phases and values of G of the
+ * lattice sums are computed in single precision.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "crandall.h"
+#include "lattice.h"
+#include "tools.h"
+
+#include "zetaf.h"
+
+/*!
+ * @brief number of summands for which G is evaluated at once.
+ */
+#define G_BLOCK_F 64
+
+/**
+ * @brief precomputes the phases of enumerated summands along each axis in
+ * single precision. The phases are computed in double precision and rounded.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] w: vector in the phase.
+ * @param[in] rows: enumerated lattice points.
+ * @param[out] phases: for each axis k, the phases for zv[k] = lower[k], ...,
+ * upper[k], stored one after another.
+ * @param[out] offsets: index of the first phase of each axis in phases.
+ */
+void phaseTablef(unsigned int dim, const double *m, const double *w,
+                 const struct latticeRows *rows, float complex *phases,
+                 long *offsets) {
+    long offset = 0;
+    for (int k = 0; k < dim; k++) {
+        double mw = 0;
+        for (int i = 0; i < dim; i++) {
+            mw += m[i * dim + k] * w[i];
+        }
+        offsets[k] = offset;
+        for (int c = rows->lower[k]; c <= rows->upper[k]; c++) {
+            phases[offset++] = cexp(-2 * M_PI * I * c * mw);
+        }
+    }
+}
+
+/**
+ * @brief multiplies the phases of all axes but the first from a single
+ * precision phase table.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] zv: counting vector of the summand.
+ * @param[in] rows: enumerated lattice points.
+ * @param[in] phases: phase table computed by phaseTablef.
+ * @param[in] offsets: offsets computed by phaseTablef.
+ * @return prod_{k > 0} exp(-2 * PI * I * zv[k] * (m^T w)[k])
+ */
+float complex phaseOuterf(unsigned int dim, const int *zv,
+                          const struct latticeRows *rows,
+                          const float complex *phases, const long *offsets) {
+    float complex rot = 1;
+    for (int k = 1; k < dim; k++) {
+        rot *= phases[offsets[k] + zv[k] - rows->lower[k]];
+    }
+    return rot;
+}
+
+/**
+ * @brief sums the summands of one of the lattice sums in Crandall's formula in
+ * single precision with Kahan's method.
+ * @param[in] nu: exponent of G.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase.
+ * @param[in] rot: phase factor of all summands.
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] radius: cutoff radius of the sum.
+ * @param[in] skipZero: true to skip the summand for zv = 0.
+ * @param[in] zArgBound: bound on when to use the asymptotic expansion in G.
+ * @return sum_{zv} G(argScale |m zv + shift|^2) exp(-2 * PI * I * (m zv) * w),
+ * NAN if memory allocation fails.
+ */
+float complex sum_latticef(float nu, unsigned int dim, const double *m,
+                           const double *shift, const double *w,
+                           float complex rot, double argScale, double radius,
+                           bool skipZero, float zArgBound) {
+    struct latticeRows *rows = latticeRowsCreate(dim, m, shift, radius);
+    struct latticeWalker *walker =
+        rows == NULL ? NULL
+                     : latticeWalkerCreate(dim, m, shift, rows,
+                                           LATTICE_EXACT_ARG / argScale, 0);
+    if (walker == NULL) {
+        latticeRowsFree(rows);
+        return NAN;
+    }
+    long end = rows->nPoints;
+    long zeroIndex = skipZero ? rows->zeroIndex : -1;
+    float complex sum = 0;
+    float complex epsilon = 0;
+    float complex auxt;
+    float complex auxy;
+    float complex rots[G_BLOCK_F];
+    float zArguments[G_BLOCK_F];
+    float gs[G_BLOCK_F];
+    float complex phases[phaseTableSize(rows)];
+    long offsets[dim];
+    phaseTablef(dim, m, w, rows, phases, offsets);
+    float complex rotOuter =
+        rot * phaseOuterf(dim, walker->zv, rows, phases, offsets);
+    for (long block = 0; block < end; block += G_BLOCK_F) {
+        unsigned int nBlock = 0;
+        for (long n = block; n < end && n < block + G_BLOCK_F; n++) {
+            if (n != zeroIndex) {
+                rots[nBlock] = rotOuter * phases[walker->zv[0] - rows->lower[0]];
+                zArguments[nBlock] = walker->r2 * argScale;
+                nBlock++;
+            }
+            if (latticeWalkerNext(walker)) {
+                rotOuter = rot * phaseOuterf(dim, walker->zv, rows, phases, offsets);
+            }
+        }
+        crandall_gBlockf(nu, nBlock, zArguments, zArgBound, gs);
+        for (unsigned int j = 0; j < nBlock; j++) {
+            // summing using Kahan's method
+            auxy = rots[j] * gs[j] - epsilon;
+            auxt = sum + auxy;
+            epsilon = (auxt - sum) - auxy;
+            sum = auxt;
+        }
+    }
+    latticeWalkerFree(walker);
+    latticeRowsFree(rows);
+    return sum;
+}
+
+/**
+ * @brief calculates the first sum in Crandall's formula in single precision.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: projection of x vector to elementary lattice cell.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @return first sum, NAN if memory allocation fails.
+ */
+float complex sum_realf(const struct epsteinZetaPlan *plan, const double *x,
+                        const double *y) {
+    unsigned int dim = plan->dim;
+    double shift[dim];
+    for (int i = 0; i < dim; i++) {
+        shift[i] = -x[i];
+    }
+    return sum_latticef(plan->nu, dim, plan->m_real, shift, y, 1,
+                        M_PI / (plan->lambda * plan->lambda), plan->radiusReal,
+                        false, plan->zArgBound);
+}
+
+/**
+ * @brief calculates the second sum in Crandall's formula in single precision.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector in the phase of the second sum.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @return second sum without the summand for k = 0, NAN if memory allocation
+ * fails.
+ */
+float complex sum_fourierf(const struct epsteinZetaPlan *plan, const double *x,
+                           const double *y) {
+    unsigned int dim = plan->dim;
+    float complex rotY = cexp(-2 * M_PI * I * dot(dim, y, x));
+    return sum_latticef(dim - plan->nu, dim, plan->m_fourier, y, x, rotY,
+                        M_PI * plan->lambda * plan->lambda, plan->radiusFourier,
+                        true, plan->zArgBound);
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function from a plan with the
+ * lattice sums in single precision.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the (regularized) Epstein zeta.
+ */
+float complex epsteinZetaPlanExecuteInternalf(const struct epsteinZetaPlan *plan,
+                                              const float *x, const float *y,
+                                              int reg) {
+    double nu = plan->nu;
+    unsigned int dim = plan->dim;
+    double ms = plan->ms;
+    double x_t1[dim];
+    double y_t1[dim];
+    for (int i = 0; i < dim; i++) {
+        x_t1[i] = x[i] * ms;
+        y_t1[i] = y[i] / ms;
+    }
+    double *x_t2 = vectorProj(dim, plan->m_real, plan->m_realInvt, x_t1);
+    double *y_t2 = vectorProj(dim, plan->m_realInvt, plan->m_real, y_t1);
+    double complex res;
+    if (!specialCase(nu, dim, x_t1, x_t2, y_t2, reg, &res)) {
+        const double *xf = reg ? x_t1 : x_t2;
+        double complex s1 = sum_realf(plan, x_t2, y_t2);
+        double complex s2 = sum_fourierf(plan, xf, y_t2);
+        res = assembleCrandall(plan, nu, plan->zArgBound, x_t1, x_t2, y_t1, y_t2,
+                               reg, s1, s2);
+    }
+    free(x_t2);
+    free(y_t2);
+    return pow(ms, nu) * res;
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function with the lattice
+ * sums in single precision.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the (regularized) Epstein zeta.
+ */
+float complex epsteinZetaInternalf(float nu, unsigned int dim, const float *a,
+                                   const float *x, const float *y, int reg) {
+    double m[dim * dim];
+    for (int i = 0; i < dim * dim; i++) {
+        m[i] = a[i];
+    }
+    struct epsteinZetaPlan *plan =
+        epsteinZetaPlanInternal(nu, dim, m, 0, ZETAF_TOL);
+    if (plan == NULL) {
+        return NAN;
+    }
+    float complex res = epsteinZetaPlanExecuteInternalf(plan, x, y, reg);
+    epsteinZetaPlanFree(plan);
+    return res;
+}
+#undef G_BLOCK_F
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file zetaf.h
+ * @brief Calculates the (regularized) Epstein zeta function with the lattice
+ * sums in single precision.
+ */
+
+#ifndef ZETAF_H
+#define ZETAF_H
+#include <complex.h>
+
+#include "zeta.h"
+
+/*!
+ * @brief tolerance of the plans for the single precision lattice sums.
+ */
+#define ZETAF_TOL 1e-6
+
+/**
+ * @brief precomputes the phases exp(-2 * PI * I * zv[k] * (m^T w)[k]) of
+ * enumerated summands along each axis in single precision.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] w: vector in the phase.
+ * @param[in] rows: enumerated lattice points.
+ * @param[out] phases: for each axis k, the phases for zv[k] = lower[k], ...,
+ * upper[k], stored one after another.
+ * @param[out] offsets: index of the first phase of each axis in phases.
+ */
+void phaseTablef(unsigned int dim, const double *m, const double *w,
+                 const struct latticeRows *rows, float complex *phases,
+                 long *offsets);
+
+/**
+ * @brief calculates the first sum in Crandall's formula in single precision.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: projection of x vector to elementary lattice cell.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @return first sum, NAN if memory allocation fails.
+ */
+float complex sum_realf(const struct epsteinZetaPlan *plan, const double *x,
+                        const double *y);
+
+/**
+ * @brief calculates the second sum in Crandall's formula in single precision.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector in the phase of the second sum.
+ * @param[in] y: projection of y vector to elementary lattice cell.
+ * @return second sum without the summand for k = 0, NAN if memory allocation
+ * fails.
+ */
+float complex sum_fourierf(const struct epsteinZetaPlan *plan, const double *x,
+                           const double *y);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function from a plan with the
+ * lattice sums in single precision.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the (regularized) Epstein zeta.
+ */
+float complex epsteinZetaPlanExecuteInternalf(const struct epsteinZetaPlan *plan,
+                                              const float *x, const float *y,
+                                              int reg);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function with the lattice
+ * sums in single precision.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] a: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the (regularized) Epstein zeta.
+ */
+float complex epsteinZetaInternalf(float nu, unsigned int dim, const float *a,
+                                   const float *x, const float *y, int reg);
+#endif
@@ -0,0 +1,335 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file zetaq.c
+ * @brief Calculates the (regularized) Epstein zeta function in quadruple
+ * precision. The scaled and reduced lattice matrix of a plan is taken as exact,
+ * its dual, the projections, both sums, G and the assembly of Crandall's formula
+ * are computed with __float128, such that the cancellation between the sums and
+ * the regularization close to nu = dim does not cost digits of the result in
+ * double precision. Only the enumeration of the lattice points stays in double
+ * precision.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "crandall.h"
+#include "crandallq.h"
+#include "lattice.h"
+
+#include "zetaq.h"
+
+/**
+ * @brief calculates the scalar product of two vectors in quadruple precision.
+ * @param[in] dim: dimension of the vectors.
+ * @param[in] v1: first vector.
+ * @param[in] v2: second vector.
+ * @return v1 * v2
+ */
+__float128 dotq(unsigned int dim, const __float128 *v1, const __float128 *v2) {
+    __float128 res = 0;
+    for (int i = 0; i < dim; i++) {
+        res += v1[i] * v2[i];
+    }
+    return res;
+}
+
+/**
+ * @brief calculates a phase in quadruple precision.
+ * @param[in] t: scalar product in the phase, reduced modulo 1 before the
+ * multiplication with 2 * PI.
+ * @return exp(-2 * PI * I * t)
+ */
+__complex128 phaseq(__float128 t) {
+    return cexpiq(-2 * M_PIq * (t - nearbyintq(t)));
+}
+
+/**
+ * @brief computes the inverse transposed and the volume of a lattice in
+ * quadruple precision.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[out] m_invt: inverse transposed of m.
+ * @return absolute value of the determinant of m.
+ */
+__float128 latticeDualq(unsigned int dim, const double *m, __float128 *m_invt) {
+    __float128 a[dim * dim];
+    __float128 r[dim * dim];
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            a[dim * i + j] = m[dim * i + j];
+            r[dim * i + j] = i == j;
+        }
+    }
+    // Gauss-Jordan elimination with partial pivoting
+    __float128 det = 1;
+    for (int c = 0; c < dim; c++) {
+        int p = c;
+        for (int i = c + 1; i < dim; i++) {
+            if (fabsq(a[dim * i + c]) > fabsq(a[dim * p + c])) {
+                p = i;
+            }
+        }
+        for (int j = 0; j < dim; j++) {
+            __float128 aux = a[dim * c + j];
+            a[dim * c + j] = a[dim * p + j];
+            a[dim * p + j] = aux;
+            aux = r[dim * c + j];
+            r[dim * c + j] = r[dim * p + j];
+            r[dim * p + j] = aux;
+        }
+        __float128 pivot = a[dim * c + c];
+        det *= pivot;
+        for (int j = 0; j < dim; j++) {
+            a[dim * c + j] /= pivot;
+            r[dim * c + j] /= pivot;
+        }
+        for (int i = 0; i < dim; i++) {
+            __float128 f = a[dim * i + c];
+            if (i == c || f == 0) {
+                continue;
+            }
+            for (int j = 0; j < dim; j++) {
+                a[dim * i + j] -= f * a[dim * c + j];
+                r[dim * i + j] -= f * r[dim * c + j];
+            }
+        }
+    }
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            m_invt[dim * i + j] = r[dim * j + i];
+        }
+    }
+    return fabsq(det);
+}
+
+/**
+ * @brief calculates the projection of a vector to the elementary lattice cell in
+ * quadruple precision.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[in] m_invt: inverse transposed of m.
+ * @param[in] v: vector to project.
+ * @param[out] vres: v - m n with the integer vector n closest to m^(-1) v.
+ */
+void vectorProjq(unsigned int dim, const __float128 *m, const __float128 *m_invt,
+                 const __float128 *v, __float128 *vres) {
+    __float128 n[dim];
+    for (int i = 0; i < dim; i++) {
+        n[i] = 0;
+        for (int j = 0; j < dim; j++) {
+            n[i] += m_invt[dim * j + i] * v[j];
+        }
+        n[i] = nearbyintq(n[i]);
+    }
+    for (int i = 0; i < dim; i++) {
+        vres[i] = v[i];
+        for (int j = 0; j < dim; j++) {
+            vres[i] -= m[dim * i + j] * n[j];
+        }
+    }
+}
+
+/**
+ * @brief sums the summands of one of the lattice sums in Crandall's formula in
+ * quadruple precision. The points are enumerated in double precision, but
+ * computed from the counting vectors in quadruple precision.
+ * @param[in] nu: exponent of G.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] md: matrix that transforms the lattice in double precision.
+ * @param[in] m: matrix that transforms the lattice in quadruple precision.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase.
+ * @param[in] rot: phase factor of all summands.
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] radius: cutoff radius of the sum.
+ * @param[in] skipZero: true to skip the summand for zv = 0.
+ * @param[out] sum: sum_{zv} G(argScale |m zv + shift|^2) exp(-2 * PI * I *
+ * (m zv) * w) * rot.
+ * @return false if memory allocation fails.
+ */
+bool sum_latticeq(__float128 nu, unsigned int dim, const double *md,
+                  const __float128 *m, const __float128 *shift,
+                  const __float128 *w, __complex128 rot, __float128 argScale,
+                  double radius, bool skipZero, __complex128 *sum) {
+    double shiftd[dim];
+    for (int i = 0; i < dim; i++) {
+        shiftd[i] = (double)shift[i];
+    }
+    struct latticeRows *rows = latticeRowsCreate(dim, md, shiftd, radius);
+    struct latticeWalker *walker =
+        rows == NULL ? NULL : latticeWalkerCreate(dim, md, shiftd, rows, 0, 0);
+    if (walker == NULL) {
+        latticeRowsFree(rows);
+        return false;
+    }
+    long zeroIndex = skipZero ? rows->zeroIndex : -1;
+    __complex128 s = 0;
+    for (long n = 0; n < rows->nPoints; n++) {
+        if (n != zeroIndex) {
+            __float128 r2 = 0;
+            __float128 mw = 0;
+            for (int i = 0; i < dim; i++) {
+                __float128 p = 0;
+                for (int j = 0; j < dim; j++) {
+                    p += m[dim * i + j] * walker->zv[j];
+                }
+                mw += p * w[i];
+                r2 += (p + shift[i]) * (p + shift[i]);
+            }
+            s += crandall_gq(nu, argScale * r2) * phaseq(mw);
+        }
+        latticeWalkerNext(walker);
+    }
+    latticeWalkerFree(walker);
+    latticeRowsFree(rows);
+    *sum = rot * s;
+    return true;
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function from a plan in
+ * quadruple precision.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the (regularized) Epstein zeta, rounded to double
+ * precision.
+ */
+double complex epsteinZetaPlanExecuteInternalq(const struct epsteinZetaPlan *plan,
+                                               const double *x, const double *y,
+                                               int reg) {
+    double nu = plan->nu;
+    unsigned int dim = plan->dim;
+    double ms = plan->ms;
+    __float128 lambda = plan->lambda;
+    // the dual of the reduced lattice matrix in quadruple precision, reduced with
+    // the integer matrix m_real^T m_fourier of the plan
+    __float128 m[dim * dim];
+    __float128 m_invt[dim * dim];
+    __float128 m_fourier[dim * dim];
+    __float128 vol = latticeDualq(dim, plan->m_real, m_invt);
+    double u[dim * dim];
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            m[dim * i + j] = plan->m_real[dim * i + j];
+            u[dim * i + j] = 0;
+            for (int k = 0; k < dim; k++) {
+                u[dim * i + j] +=
+                    plan->m_real[dim * k + i] * plan->m_fourier[dim * k + j];
+            }
+            u[dim * i + j] = nearbyint(u[dim * i + j]);
+        }
+    }
+    for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+            m_fourier[dim * i + j] = 0;
+            for (int k = 0; k < dim; k++) {
+                m_fourier[dim * i + j] += m_invt[dim * i + k] * u[dim * k + j];
+            }
+        }
+    }
+    __float128 x_t1[dim];
+    __float128 y_t1[dim];
+    __float128 x_t2[dim];
+    __float128 y_t2[dim];
+    for (int i = 0; i < dim; i++) {
+        x_t1[i] = (__float128)x[i] * ms;
+        y_t1[i] = (__float128)y[i] / ms;
+    }
+    vectorProjq(dim, m, m_invt, x_t1, x_t2);
+    vectorProjq(dim, m_invt, m, y_t1, y_t2);
+    double x_t1d[dim];
+    double x_t2d[dim];
+    double y_t2d[dim];
+    for (int i = 0; i < dim; i++) {
+        x_t1d[i] = (double)x_t1[i];
+        x_t2d[i] = (double)x_t2[i];
+        y_t2d[i] = (double)y_t2[i];
+    }
+    double complex special;
+    if (specialCase(nu, dim, x_t1d, x_t2d, y_t2d, reg, &special)) {
+        return pow(ms, nu) * special;
+    }
+    // cutoffs for quadruple precision with the weight lambda of the plan
+    double radiusReal = (crandall_gCutoff(dim, nu, ZETAQ_TOL) + 0.5) * plan->lambda;
+    double radiusFourier =
+        (crandall_gCutoff(dim, dim - nu, ZETAQ_TOL) + 0.5) / plan->lambda;
+    const __float128 *xf = reg ? x_t1 : x_t2;
+    __float128 shift[dim];
+    for (int i = 0; i < dim; i++) {
+        shift[i] = -x_t2[i];
+    }
+    __float128 argScaleFourier = M_PIq * lambda * lambda;
+    __complex128 s1;
+    __complex128 s2;
+    if (!sum_latticeq(nu, dim, plan->m_real, m, shift, y_t2, 1,
+                      M_PIq / (lambda * lambda), radiusReal, false, &s1) ||
+        !sum_latticeq(dim - nu, dim, plan->m_fourier, m_fourier, y_t2, xf,
+                      phaseq(dotq(dim, y_t2, xf)), argScaleFourier,
+                      radiusFourier, true, &s2)) {
+        return NAN;
+    }
+    __float128 vx[dim];
+    for (int i = 0; i < dim; i++) {
+        vx[i] = x_t1[i] - x_t2[i];
+    }
+    __complex128 xfactor = phaseq(dotq(dim, vx, y_t1));
+    __float128 argY1 = argScaleFourier * dotq(dim, y_t1, y_t1);
+    __float128 argY2 = argScaleFourier * dotq(dim, y_t2, y_t2);
+    if (reg) {
+        // calculate regularized Epstein Zeta function values.
+        __complex128 nc = crandall_gRegq(dim - nu, argY1, lambda);
+        __complex128 rot = conjq(phaseq(dotq(dim, x_t1, y_t1)));
+        // correct wrong zero summand in regularized fourier sum.
+        bool equal = true;
+        for (int i = 0; i < dim; i++) {
+            equal = equal && y_t1[i] == y_t2[i];
+        }
+        if (!equal) {
+            s2 += crandall_gq(dim - nu, argY2) * phaseq(dotq(dim, x_t1, y_t2)) -
+                  crandall_gq(dim - nu, argY1) * phaseq(dotq(dim, x_t1, y_t1));
+        }
+        s2 = s2 * rot + nc;
+        s1 = s1 * rot * xfactor;
+        xfactor = 1;
+    } else {
+        // calculate non regularized Epstein Zeta function values.
+        s2 += crandall_gq(dim - nu, argY2) * phaseq(dotq(dim, x_t2, y_t2));
+    }
+    __complex128 res = xfactor * powq(lambda * lambda / M_PIq, -nu / 2.) /
+                       tgammaq(nu / 2.) * (s1 + powq(lambda, dim) / vol * s2);
+    res *= powq(ms, nu);
+    return (double)crealq(res) + I * (double)cimagq(res);
+}
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function in quadruple
+ * precision.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the (regularized) Epstein zeta, rounded to double
+ * precision.
+ */
+double complex epsteinZetaInternalq(double nu, unsigned int dim, const double *m,
+                                    const double *x, const double *y, int reg) {
+    struct epsteinZetaPlan *plan = epsteinZetaPlanInternal(nu, dim, m, 0, 0);
+    if (plan == NULL) {
+        return NAN;
+    }
+    double complex res = epsteinZetaPlanExecuteInternalq(plan, x, y, reg);
+    epsteinZetaPlanFree(plan);
+    return res;
+}
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2024 Andreas Buchheit <buchheit@num.uni-sb.de>
+// SPDX-FileCopyrightText: 2024 Jonathan Busse <jonathan.busse@dlr.de>
+// SPDX-FileCopyrightText: 2024 Ruben Gutendorf
+// <ruben.gutendorf@uni-saarland.de>
+//
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/**
+ * @file zetaq.h
+ * @brief Calculates the (regularized) Epstein zeta function in quadruple
+ * precision.
+ */
+
+#ifndef ZETAQ_H
+#define ZETAQ_H
+#include <complex.h>
+#include <quadmath.h>
+#include <stdbool.h>
+
+#include "zeta.h"
+
+/*!
+ * @brief tolerance for the neglected summands of the lattice sums in quadruple
+ * precision.
+ */
+#define ZETAQ_TOL 1e-32
+
+/**
+ * @brief computes the inverse transposed and the volume of a lattice in
+ * quadruple precision.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] m: matrix that transforms the lattice.
+ * @param[out] m_invt: inverse transposed of m.
+ * @return absolute value of the determinant of m.
+ */
+__float128 latticeDualq(unsigned int dim, const double *m, __float128 *m_invt);
+
+/**
+ * @brief sums the summands of one of the lattice sums in Crandall's formula in
+ * quadruple precision. The points are enumerated in double precision, but
+ * computed from the counting vectors in quadruple precision.
+ * @param[in] nu: exponent of G.
+ * @param[in] dim: dimension of the lattice.
+ * @param[in] md: matrix that transforms the lattice in double precision.
+ * @param[in] m: matrix that transforms the lattice in quadruple precision.
+ * @param[in] shift: shift of the lattice points.
+ * @param[in] w: vector in the phase.
+ * @param[in] rot: phase factor of all summands.
+ * @param[in] argScale: factor from the squared norms to the arguments of G.
+ * @param[in] radius: cutoff radius of the sum.
+ * @param[in] skipZero: true to skip the summand for zv = 0.
+ * @param[out] sum: sum_{zv} G(argScale |m zv + shift|^2) exp(-2 * PI * I *
+ * (m zv) * w) * rot.
+ * @return false if memory allocation fails.
+ */
+bool sum_latticeq(__float128 nu, unsigned int dim, const double *md,
+                  const __float128 *m, const __float128 *shift,
+                  const __float128 *w, __complex128 rot, __float128 argScale,
+                  double radius, bool skipZero, __complex128 *sum);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function from a plan in
+ * quadruple precision.
+ * @param[in] plan: precomputed data for fixed nu, lattice and lambda.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the (regularized) Epstein zeta, rounded to double
+ * precision.
+ */
+double complex epsteinZetaPlanExecuteInternalq(const struct epsteinZetaPlan *plan,
+                                               const double *x, const double *y,
+                                               int reg);
+
+/**
+ * @brief calculates the (regularized) Epstein Zeta function in quadruple
+ * precision.
+ * @param[in] nu: exponent for the Epstein zeta function.
+ * @param[in] dim: dimension of the input vectors.
+ * @param[in] m: matrix that transforms the lattice in the Epstein Zeta function.
+ * @param[in] x: x vector of the Epstein Zeta function.
+ * @param[in] y: y vector of the Epstein Zeta function.
+ * @param[in] reg: 0 for no regularization, > 0 for the regularization.
+ * @return function value of the (regularized) Epstein zeta, rounded to double
+ * precision.
+ */
+double complex epsteinZetaInternalq(double nu, unsigned int dim, const double *m,
+                                    const double *x, const double *y, int reg);
+#endif